@@ -162,6 +162,9 @@ FT_BEGIN_HEADER
    *   FT_Reference_Face
    *   FT_New_Memory_Face
    *   FT_Face_Properties
+   *   FT_Face_GetMemoryUsage
+   *   FT_Size_GetMemoryUsage
+   *   FT_Face_SetMemoryBudget
    *   FT_Open_Face
    *   FT_Open_Args
    *   FT_Parameter
@@ -214,6 +217,8 @@ FT_BEGIN_HEADER
    *   FT_LOAD_TARGET_MODE
    *
    *   FT_Render_Glyph
+   *   FT_Render_Glyph_Subpixel
+   *   FT_Render_Glyph_Run
    *   FT_Render_Mode
    *   FT_Get_Kerning
    *   FT_Kerning_Mode
@@ -3373,6 +3378,134 @@ FT_BEGIN_HEADER
                    FT_Render_Mode  render_mode );
 
 
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Render_Glyph_Subpixel
+   *
+   * @description:
+   *   Like @FT_Render_Glyph, but shift the glyph image horizontally by a
+   *   fraction of a pixel before rendering it.  This is meant for layout
+   *   engines that position glyphs at sub-pixel pen positions.
+   *
+   *   To limit the number of distinct bitmaps per glyph, the offset is
+   *   quantized to one of `num_bins` equally spaced positions within a
+   *   pixel.
+   *
+   * @inout:
+   *   slot ::
+   *     A handle to the glyph slot containing the image to convert.
+   *
+   * @input:
+   *   render_mode ::
+   *     The render mode used to render the glyph image into a bitmap.  See
+   *     @FT_Render_Mode for a list of possible values.
+   *
+   *   x_offset ::
+   *     The horizontal offset in 26.6 pixel format.  Only the fractional
+   *     part is used; it gets truncated to the nearest bin to the left.
+   *
+   *   num_bins ::
+   *     The number of sub-pixel positions per pixel, for example~4 for
+   *     quarter-pixel positioning.  Must not be zero; values larger
+   *     than~64 are treated as~64.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   A typical layout loop splits the 26.6 pen position `pen_x` as
+   *   follows, which rounds it to the nearest bin.
+   *
+   *   ```
+   *     FT_Pos  x = pen_x + 32 / num_bins;
+   *
+   *
+   *     FT_Render_Glyph_Subpixel( slot, mode, x & 63, num_bins );
+   *     draw_bitmap( &slot->bitmap,
+   *                  ( x >> 6 ) + slot->bitmap_left, ... );
+   *   ```
+   *
+   *   The shift is reflected in the rendered bitmap and in `bitmap_left`;
+   *   the glyph metrics and the advance are not changed.  Embedded
+   *   bitmaps (and other glyph images in bitmap format) are not shifted.
+   *
+   *   See @FTC_SBitCache_LookupSubpixel for a cached version.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Render_Glyph_Subpixel( FT_GlyphSlot    slot,
+                            FT_Render_Mode  render_mode,
+                            FT_Pos          x_offset,
+                            FT_UInt         num_bins );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Render_Glyph_Run
+   *
+   * @description:
+   *   Load a sequence of glyphs and render them all at once into a
+   *   caller-provided anti-aliased bitmap.  This avoids the per-glyph
+   *   set-up of the rasterizer and the allocation of a bitmap per glyph
+   *   that @FT_Load_Glyph and @FT_Render_Glyph need.
+   *
+   * @input:
+   *   face ::
+   *     A handle to the source face object.  The current size, transform,
+   *     and variation instance are used.
+   *
+   *   num_glyphs ::
+   *     The number of glyphs to render.
+   *
+   *   glyph_indices ::
+   *     An array of `num_glyphs` glyph indices.
+   *
+   *   positions ::
+   *     An array of `num_glyphs` glyph origins in 26.6 pixel format,
+   *     relative to the lower left corner of `target`, with the y~axis
+   *     pointing upwards (as with @FT_Outline_Get_Bitmap).
+   *
+   *   load_flags ::
+   *     The flags used to load the glyphs; see @FT_LOAD_XXX.
+   *     @FT_LOAD_RENDER and @FT_LOAD_COLOR are ignored, and
+   *     @FT_LOAD_NO_BITMAP is implied.
+   *
+   * @inout:
+   *   target ::
+   *     The bitmap to render into.  Its pixel mode must be
+   *     @FT_PIXEL_MODE_GRAY; the function does not allocate it.  It should
+   *     be cleared before the call.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   The glyph outlines are merged into a single outline and rendered in
+   *   one pass, so overlapping glyphs are combined with the fill rule of
+   *   the font (that is, their union is taken) instead of adding up their
+   *   coverage.  Glyphs outside of `target` are skipped after loading.
+   *   Very long runs with more than 32767 outline points are rendered in
+   *   chunks, with the coverage of later chunks added to the bitmap.
+   *
+   *   The glyph slot of `face` is overwritten; after the call it contains
+   *   the last glyph loaded.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Render_Glyph_Run( FT_Face           face,
+                       FT_UInt           num_glyphs,
+                       const FT_UInt*    glyph_indices,
+                       const FT_Vector*  positions,
+                       FT_Int32          load_flags,
+                       FT_Bitmap*        target );
+
+
   /**************************************************************************
    *
    * @enum:
@@ -3906,6 +4039,129 @@ FT_BEGIN_HEADER
                       FT_Parameter*  properties );
 
 
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Face_GetMemoryUsage
+   *
+   * @description:
+   *   Return the amount of heap memory currently held by a face, including
+   *   the data of its sizes, together with the peak value since it was
+   *   opened.  This only works if the face has been opened with the
+   *   @FT_PARAM_TAG_MEMORY_ACCOUNTING parameter.
+   *
+   * @input:
+   *   face ::
+   *     A handle to the source face object.
+   *
+   * @output:
+   *   acurrent ::
+   *     The number of bytes currently allocated for the face.  Can be
+   *     `NULL`.
+   *
+   *   apeak ::
+   *     The largest value `acurrent` ever had.  Can be `NULL`.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.  If the face doesn't track its
+   *   memory, `FT_Err_Invalid_Argument` is returned.
+   *
+   * @note:
+   *   Only memory obtained through the face's @FT_Memory object or its
+   *   stream is counted, for example tables extracted from the font file,
+   *   charmaps, hinting data, or variation data.  The face, size, and
+   *   glyph slot objects themselves, the accounting data, and memory owned
+   *   by the driver module (like the TrueType bytecode execution context)
+   *   are not included.  Memory-mapped
+   *   or in-memory font files don't need copies of the font tables.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Face_GetMemoryUsage( FT_Face    face,
+                          FT_ULong  *acurrent,
+                          FT_ULong  *apeak );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Size_GetMemoryUsage
+   *
+   * @description:
+   *   Return the amount of heap memory currently attributed to a size
+   *   object of a face opened with the @FT_PARAM_TAG_MEMORY_ACCOUNTING
+   *   parameter.
+   *
+   * @input:
+   *   size ::
+   *     A handle to the source size object.
+   *
+   * @output:
+   *   acurrent ::
+   *     The number of bytes allocated while the size was created, set up,
+   *     or used to load glyphs, and not freed since.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.  If the parent face doesn't
+   *   track its memory, `FT_Err_Invalid_Argument` is returned.
+   *
+   * @note:
+   *   This value is included in the face's total returned by
+   *   @FT_Face_GetMemoryUsage.  Memory allocated on demand while loading a
+   *   glyph (for example, the auto-hinter's global metrics) is attributed
+   *   to the size active at that time, even if it actually belongs to the
+   *   face.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Size_GetMemoryUsage( FT_Size    size,
+                          FT_ULong  *acurrent );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Face_SetMemoryBudget
+   *
+   * @description:
+   *   Set a soft memory budget for a face opened with the
+   *   @FT_PARAM_TAG_MEMORY_ACCOUNTING parameter.
+   *
+   *   Whenever the face's memory usage exceeds the budget, FreeType
+   *   releases data that can be reconstructed later on, namely the
+   *   auto-hinter's global metrics, decoded PostScript glyph names, and
+   *   cached font variation data, at the end of the next call to
+   *   @FT_Load_Glyph (or immediately within this function).  Allocations
+   *   never fail because of the budget.
+   *
+   * @input:
+   *   face ::
+   *     A handle to the source face object.
+   *
+   *   budget ::
+   *     The budget in bytes.  Value~0 disables it.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.  If the face doesn't track its
+   *   memory, `FT_Err_Invalid_Argument` is returned.
+   *
+   * @note:
+   *   A budget too small for the data needed to load glyphs at all makes
+   *   FreeType reconstruct the released data over and over again, which can
+   *   be very slow.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Face_SetMemoryBudget( FT_Face   face,
+                           FT_ULong  budget );
+
+
   /**************************************************************************
    *
    * @function:
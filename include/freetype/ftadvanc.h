@@ -46,11 +46,13 @@ FT_BEGIN_HEADER
    *
    * @description:
    *   This section contains functions to quickly extract advance values
-   *   without handling glyph outlines, if possible.
+   *   without handling glyph outlines, if possible.  A similar function
+   *   retrieves the extents of a glyph.
    *
    * @order:
    *   FT_Get_Advance
    *   FT_Get_Advances
+   *   FT_Get_Glyph_CBox
    *
    */
 
@@ -66,7 +68,7 @@ FT_BEGIN_HEADER
    *
    *   If set, it indicates that you want these functions to fail if the
    *   corresponding hinting mode or font driver doesn't allow for very quick
-   *   advance computation.
+   *   advance computation.  @FT_Get_Glyph_CBox accepts this flag, too.
    *
    *   Typically, glyphs that are either unscaled, unhinted, bitmapped, or
    *   light-hinted can have their advance width computed very quickly.
@@ -177,6 +179,61 @@ FT_BEGIN_HEADER
                    FT_Int32   load_flags,
                    FT_Fixed  *padvances );
 
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Get_Glyph_CBox
+   *
+   * @description:
+   *   Retrieve the control box of an unhinted glyph outline in an
+   *   @FT_Face, if possible without loading the outline.
+   *
+   *   For TrueType fonts, the box is taken from the glyph header in the
+   *   `glyf` table, which makes this much faster than @FT_Load_Glyph.
+   *   Other formats, variation fonts with active variations, and tricky
+   *   fonts load the glyph instead.
+   *
+   * @input:
+   *   face ::
+   *     The source @FT_Face handle.
+   *
+   *   gindex ::
+   *     The glyph index.
+   *
+   *   load_flags ::
+   *     A set of bit flags similar to those used when calling
+   *     @FT_Load_Glyph.  Hinting flags are ignored; the box always belongs
+   *     to the unhinted outline.
+   *
+   * @output:
+   *   acbox ::
+   *     The control box, positioned like the outline that @FT_Load_Glyph
+   *     returns.  If @FT_LOAD_NO_SCALE is set, it is in font units;
+   *     otherwise it is in 26.6 pixel format.
+   *
+   * @return:
+   *   FreeType error code.  0 means success.
+   *
+   * @note:
+   *   This function fails if you use @FT_ADVANCE_FLAG_FAST_ONLY and the
+   *   glyph would have to be loaded.
+   *
+   *   The box stored in a TrueType glyph header is used as is.  It might
+   *   thus differ slightly from the control box of the loaded outline,
+   *   mainly for composite glyphs (whose components are scaled
+   *   separately) and for fonts with outdated headers.  The box is not
+   *   transformed by @FT_Set_Transform.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Get_Glyph_CBox( FT_Face   face,
+                     FT_UInt   gindex,
+                     FT_Int32  load_flags,
+                     FT_BBox  *acbox );
+
   /* */
 
 
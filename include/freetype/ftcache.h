@@ -117,11 +117,18 @@ FT_BEGIN_HEADER
    *   FTC_ImageCache
    *   FTC_ImageCache_New
    *   FTC_ImageCache_Lookup
+   *   FTC_ImageCache_LookupTransform
    *
    *   FTC_SBit
    *   FTC_SBitCache
    *   FTC_SBitCache_New
    *   FTC_SBitCache_Lookup
+   *   FTC_SBitCache_LookupSubpixel
+   *   FTC_SBitCache_LookupTransform
+   *
+   *   FTC_OutlineCache
+   *   FTC_OutlineCache_New
+   *   FTC_OutlineCache_Lookup
    *
    *   FTC_CMapCache
    *   FTC_CMapCache_New
@@ -284,11 +291,12 @@ FT_BEGIN_HEADER
    *
    *   max_faces ::
    *     Maximum number of opened @FT_Face objects managed by this cache
-   *     instance.  Use~0 for defaults.
+   *     instance.  Use~0 for defaults, which is two faces per 200kByte of
+   *     `max_bytes` (but at most 512 faces).
    *
    *   max_sizes ::
    *     Maximum number of opened @FT_Size objects managed by this cache
-   *     instance.  Use~0 for defaults.
+   *     instance.  Use~0 for defaults, which is twice `max_faces`.
    *
    *   max_bytes ::
    *     Maximum number of bytes to use for cached data nodes.  Use~0 for
@@ -849,6 +857,77 @@ FT_BEGIN_HEADER
                                FTC_Node       *anode );
 
 
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_ImageCache_LookupTransform
+   *
+   * @description:
+   *   A variant of @FTC_ImageCache_LookupScaler that returns the glyph
+   *   image loaded with a transformation, as if set with
+   *   @FT_Set_Transform.  The transformation is part of the cache key.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the source glyph image cache.
+   *
+   *   scaler ::
+   *     A pointer to a scaler descriptor.
+   *
+   *   load_flags ::
+   *     The corresponding load flags.
+   *
+   *   matrix ::
+   *     A pointer to the transformation's 2x2 matrix.  Use NULL for the
+   *     identity matrix.
+   *
+   *   delta ::
+   *     A pointer to the translation vector in 26.6 pixel format.  Use NULL
+   *     for the null vector.
+   *
+   *   gindex ::
+   *     The glyph index to retrieve.
+   *
+   * @output:
+   *   aglyph ::
+   *     The corresponding @FT_Glyph object.  0~in case of failure.
+   *
+   *   anode ::
+   *     Used to return the address of the corresponding cache node after
+   *     incrementing its reference count (see @FTC_ImageCache_Lookup).
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   The matrix coefficients are rounded to multiples of 1/4096 so that
+   *   nearly identical transformations share cache entries.  Of `delta`,
+   *   only the fraction left after flooring to whole pixels is used, that
+   *   is, `delta->x & 63` and `delta->y & 63`; for example, a value of -10
+   *   gives 54.  The caller is expected to add the floored part when
+   *   positioning the glyph.
+   *
+   *   A non-identity transformation replaces the one set on the cached
+   *   face with @FT_Set_Transform while the glyph gets loaded; the face's
+   *   transformation is restored afterwards.  If the matrix is the
+   *   identity (or NULL) and the fraction of `delta` is zero, the lookup
+   *   is the same as with @FTC_ImageCache_LookupScaler, and the face's
+   *   own transformation, if any, still applies.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FTC_ImageCache_LookupTransform( FTC_ImageCache    cache,
+                                  FTC_Scaler        scaler,
+                                  FT_ULong          load_flags,
+                                  const FT_Matrix*  matrix,
+                                  const FT_Vector*  delta,
+                                  FT_UInt           gindex,
+                                  FT_Glyph         *aglyph,
+                                  FTC_Node         *anode );
+
+
   /**************************************************************************
    *
    * @type:
@@ -1076,6 +1155,237 @@ FT_BEGIN_HEADER
                               FTC_SBit      *sbit,
                               FTC_Node      *anode );
 
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_SBitCache_LookupSubpixel
+   *
+   * @description:
+   *   A variant of @FTC_SBitCache_LookupScaler that returns the glyph
+   *   bitmap rendered at a horizontal sub-pixel offset.  The offset is
+   *   quantized exactly as with @FT_Render_Glyph_Subpixel, and the
+   *   quantized offset becomes part of the cache key, so each glyph is
+   *   cached at most once per bin.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the source sbit cache.
+   *
+   *   scaler ::
+   *     A pointer to the scaler descriptor.
+   *
+   *   load_flags ::
+   *     The corresponding load flags.
+   *
+   *   gindex ::
+   *     The glyph index.
+   *
+   *   x_offset ::
+   *     The horizontal offset in 26.6 pixel format.  Only the fractional
+   *     part is used.
+   *
+   *   num_bins ::
+   *     The number of sub-pixel positions per pixel.  Must not be zero.
+   *
+   * @output:
+   *   sbit ::
+   *     A handle to a small bitmap descriptor.
+   *
+   *   anode ::
+   *     Used to return the address of the corresponding cache node after
+   *     incrementing its reference count (see @FTC_SBitCache_Lookup).
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   Lookups whose offsets fall into the first bin share their entries
+   *   with @FTC_SBitCache_LookupScaler.  Since the offset is expressed in
+   *   26.6 units internally, different bin counts that yield the same
+   *   offset (for example, bin~1 of~4 and bin~2 of~8) share entries, too.
+   *
+   *   The `left` field of the returned descriptor includes the shift; see
+   *   @FT_Render_Glyph_Subpixel for how to split the pen position.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FTC_SBitCache_LookupSubpixel( FTC_SBitCache  cache,
+                                FTC_Scaler     scaler,
+                                FT_ULong       load_flags,
+                                FT_UInt        gindex,
+                                FT_Pos         x_offset,
+                                FT_UInt        num_bins,
+                                FTC_SBit      *sbit,
+                                FTC_Node      *anode );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_SBitCache_LookupTransform
+   *
+   * @description:
+   *   A variant of @FTC_SBitCache_LookupScaler that returns the glyph
+   *   bitmap rendered with a transformation, as if set with
+   *   @FT_Set_Transform.  The transformation is part of the cache key.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the source sbit cache.
+   *
+   *   scaler ::
+   *     A pointer to the scaler descriptor.
+   *
+   *   load_flags ::
+   *     The corresponding load flags.
+   *
+   *   matrix ::
+   *     A pointer to the transformation's 2x2 matrix.  Use NULL for the
+   *     identity matrix.
+   *
+   *   delta ::
+   *     A pointer to the translation vector in 26.6 pixel format.  Use NULL
+   *     for the null vector.
+   *
+   *   gindex ::
+   *     The glyph index.
+   *
+   * @output:
+   *   sbit ::
+   *     A handle to a small bitmap descriptor.
+   *
+   *   anode ::
+   *     Used to return the address of the corresponding cache node after
+   *     incrementing its reference count (see @FTC_SBitCache_Lookup).
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   The key is formed as with @FTC_ImageCache_LookupTransform.  The
+   *   `xadvance` and `yadvance` fields of the returned descriptor hold the
+   *   transformed advance.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FTC_SBitCache_LookupTransform( FTC_SBitCache     cache,
+                                 FTC_Scaler        scaler,
+                                 FT_ULong          load_flags,
+                                 const FT_Matrix*  matrix,
+                                 const FT_Vector*  delta,
+                                 FT_UInt           gindex,
+                                 FTC_SBit         *sbit,
+                                 FTC_Node         *anode );
+
+
+  /**************************************************************************
+   *
+   * @type:
+   *   FTC_OutlineCache
+   *
+   * @description:
+   *   A handle to an unscaled outline cache object.  It holds the outlines
+   *   of glyphs in font units, once per face ID, and scales them on each
+   *   lookup.  This avoids decoding the glyph again for every size, which
+   *   helps applications that zoom continuously.
+   *
+   * @since:
+   *   2.10.3
+   */
+  typedef struct FTC_OutlineCacheRec_*  FTC_OutlineCache;
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_OutlineCache_New
+   *
+   * @description:
+   *   Create a new unscaled outline cache.
+   *
+   * @input:
+   *   manager ::
+   *     The parent manager for the outline cache.
+   *
+   * @output:
+   *   acache ::
+   *     A handle to the new outline cache object.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FTC_OutlineCache_New( FTC_Manager        manager,
+                        FTC_OutlineCache  *acache );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FTC_OutlineCache_Lookup
+   *
+   * @description:
+   *   Retrieve an unhinted glyph outline scaled to a given size.  The
+   *   outline is loaded in font units and cached on the first request; all
+   *   later requests for the same glyph, at any size, only scale the cached
+   *   copy.
+   *
+   * @input:
+   *   cache ::
+   *     A handle to the source outline cache.
+   *
+   *   scaler ::
+   *     A pointer to a scaler descriptor.  Only the face ID is part of the
+   *     cache key.
+   *
+   *   load_flags ::
+   *     The load flags.  @FT_LOAD_NO_SCALE is always added, which implies
+   *     @FT_LOAD_NO_HINTING and @FT_LOAD_NO_BITMAP.
+   *
+   *   gindex ::
+   *     The glyph index to retrieve.
+   *
+   * @output:
+   *   aglyph ::
+   *     A new outline @FT_Glyph object scaled to the size given by
+   *     `scaler`, including its advance.  0~in case of failure.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   Contrary to the other caches, the returned glyph is owned by the
+   *   caller, who must destroy it with @FT_Done_Glyph.
+   *
+   *   The scaling uses the scale factors of the @FT_Size object that
+   *   @FTC_Manager_LookupSize returns for `scaler`, so the result matches
+   *   @FT_Load_Glyph with @FT_LOAD_NO_HINTING up to rounding.
+   *
+   *   For variation fonts, the outline is cached for the design
+   *   coordinates the face has when the glyph is loaded first.  Use a
+   *   distinct face ID for each instance.
+   *
+   *   Glyphs that are not outlines (for example, bitmap-only fonts) give
+   *   an error.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FTC_OutlineCache_Lookup( FTC_OutlineCache  cache,
+                           FTC_Scaler        scaler,
+                           FT_ULong          load_flags,
+                           FT_UInt           gindex,
+                           FT_Glyph         *aglyph );
+
   /* */
 
 
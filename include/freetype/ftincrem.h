@@ -320,6 +320,125 @@ FT_BEGIN_HEADER
   } FT_Incremental_InterfaceRec;
 
 
+  /**************************************************************************
+   *
+   * @type:
+   *   FT_Incremental_GetGlyphDataBatchFunc
+   *
+   * @description:
+   *   A function called by FreeType to access the data bytes of several
+   *   glyphs at once.  It is used by @FT_Incremental_Prefetch, and by the
+   *   TrueType driver to fetch all components of a composite glyph with a
+   *   single call.
+   *
+   *   The data format is the same as for @FT_Incremental_GetGlyphDataFunc.
+   *
+   * @input:
+   *   incremental ::
+   *     Handle to an opaque @FT_Incremental handle provided by the client
+   *     application.
+   *
+   *   num_glyphs ::
+   *     The number of elements in `glyph_indices` and `adata`.
+   *
+   *   glyph_indices ::
+   *     The indices of the relevant glyphs, sorted in increasing order and
+   *     without duplicates.
+   *
+   * @output:
+   *   adata ::
+   *     An array of `num_glyphs` structures, zeroed by FreeType before the
+   *     call.  Set the `pointer` field of an element to describe the data
+   *     bytes of the corresponding glyph, or leave it unchanged if the
+   *     glyph's data is not available yet.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.  In case of an error, no data
+   *   must be returned.
+   *
+   * @note:
+   *   FreeType calls @FT_Incremental_FreeGlyphDataFunc for every returned
+   *   element, either after the glyph has been loaded or when the face is
+   *   destroyed.  Glyphs without data are requested later on with
+   *   @FT_Incremental_GetGlyphDataFunc as usual.
+   *
+   * @since:
+   *   2.10.3
+   *
+   */
+  typedef FT_Error
+  (*FT_Incremental_GetGlyphDataBatchFunc)( FT_Incremental  incremental,
+                                           FT_UInt         num_glyphs,
+                                           const FT_UInt*  glyph_indices,
+                                           FT_Data*        adata );
+
+
+  /**************************************************************************
+   *
+   * @struct:
+   *   FT_Incremental_BatchFuncsRec
+   *
+   * @description:
+   *   A table of optional functions for accessing the glyph data of
+   *   incremental fonts in batches.  It gets passed to @FT_Open_Face with
+   *   the @FT_PARAM_TAG_INCREMENTAL_BATCH tag, in addition to an
+   *   @FT_Incremental_InterfaceRec structure; the functions receive the
+   *   latter's `object` field.
+   *
+   * @fields:
+   *   get_glyph_data_batch ::
+   *     The function to get the data of several glyphs.  Must not be null.
+   *
+   * @since:
+   *   2.10.3
+   *
+   */
+  typedef struct  FT_Incremental_BatchFuncsRec_
+  {
+    FT_Incremental_GetGlyphDataBatchFunc  get_glyph_data_batch;
+
+  } FT_Incremental_BatchFuncsRec;
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Incremental_Prefetch
+   *
+   * @description:
+   *   Fetch the data of several glyphs of an incremental font with a single
+   *   call to @FT_Incremental_GetGlyphDataBatchFunc.  The data is kept in
+   *   the face object until the corresponding glyph gets loaded with
+   *   @FT_Load_Glyph.
+   *
+   * @input:
+   *   face ::
+   *     A handle to the source face object.
+   *
+   *   num_glyphs ::
+   *     The number of elements in `glyph_indices`.
+   *
+   *   glyph_indices ::
+   *     The indices of the glyphs to prefetch, in arbitrary order.
+   *     Duplicates and glyphs whose data is already prefetched are ignored.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   This function does nothing if the face was not opened with both
+   *   @FT_PARAM_TAG_INCREMENTAL and @FT_PARAM_TAG_INCREMENTAL_BATCH.
+   *
+   * @since:
+   *   2.10.3
+   *
+   */
+  FT_EXPORT( FT_Error )
+  FT_Incremental_Prefetch( FT_Face         face,
+                           FT_UInt         num_glyphs,
+                           const FT_UInt*  glyph_indices );
+
+
   /**************************************************************************
    *
    * @type:
@@ -741,6 +741,93 @@ FT_BEGIN_HEADER
   FT_Set_Named_Instance( FT_Face  face,
                          FT_UInt  instance_index );
 
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Set_Size_Var_Design_Coordinates
+   *
+   * @description:
+   *   Set variation design coordinates for a given size object only.
+   *   Glyphs loaded with this size use these coordinates instead of the
+   *   face's ones, so that several instances of a variation font can be
+   *   used simultaneously with a single @FT_Face, sharing all parsed font
+   *   data.
+   *
+   * @input:
+   *   size ::
+   *     A handle to the target size object.
+   *
+   *   num_coords ::
+   *     The number of available design coordinates.  If it is larger than
+   *     the number of axes, ignore the excess values.  If it is smaller
+   *     than the number of axes, use default values for the remaining
+   *     axes.
+   *
+   *   coords ::
+   *     An array of design coordinates.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   If `num_coords` is zero and `coords` is `NULL`, the size uses the
+   *   face's coordinates again.
+   *
+   *   The coordinates affect glyph outlines, advance widths, and hinting
+   *   of glyphs loaded with the size; @FT_Get_Advances uses the
+   *   coordinates of the face's active size.  Face-wide data like the
+   *   ascender and descender values of the face or the size (which depend
+   *   on the 'MVAR' table) always follow the face's coordinates, as does
+   *   the auto-hinter's global analysis.
+   *
+   *   Switching coordinates is cheap, but not free; it is best to group
+   *   glyph loads by size.
+   *
+   *   Currently, only TrueType variation fonts are supported.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Set_Size_Var_Design_Coordinates( FT_Size    size,
+                                      FT_UInt    num_coords,
+                                      FT_Fixed*  coords );
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Set_Size_Var_Blend_Coordinates
+   *
+   * @description:
+   *   Like @FT_Set_Size_Var_Design_Coordinates, but for normalized
+   *   coordinates in the range [-1.0;1.0].
+   *
+   * @input:
+   *   size ::
+   *     A handle to the target size object.
+   *
+   *   num_coords ::
+   *     The number of available normalized coordinates.  If it is larger
+   *     than the number of axes, ignore the excess values.  If it is
+   *     smaller than the number of axes, use default values for the
+   *     remaining axes.
+   *
+   *   coords ::
+   *     The normalized coordinates array.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Set_Size_Var_Blend_Coordinates( FT_Size    size,
+                                     FT_UInt    num_coords,
+                                     FT_Fixed*  coords );
+
   /* */
 
 
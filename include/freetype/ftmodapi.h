@@ -90,6 +90,9 @@ FT_BEGIN_HEADER
    *   FT_Property_Get
    *   FT_Set_Default_Properties
    *
+   *   FT_RFork_Guessing
+   *   FT_Library_SetRForkGuessing
+   *
    *   FT_New_Library
    *   FT_Done_Library
    *   FT_Reference_Library
@@ -500,6 +503,88 @@ FT_BEGIN_HEADER
   FT_Set_Default_Properties( FT_Library  library );
 
 
+  /**************************************************************************
+   *
+   * @enum:
+   *   FT_RFork_Guessing
+   *
+   * @description:
+   *   A list of values to control how hard @FT_Open_Face looks for a Mac
+   *   resource fork stored outside of the data fork if a file given by its
+   *   path name can't be opened otherwise; see
+   *   @FT_Library_SetRForkGuessing.
+   *
+   * @values:
+   *   FT_RFORK_GUESSING_NONE ::
+   *     Don't look for resource forks in other files.  MacBinary files,
+   *     dfonts, and resource forks with an AppleSingle or AppleDouble
+   *     header in the data fork are still recognized.
+   *
+   *   FT_RFORK_GUESSING_NATIVE ::
+   *     Only try the file name conventions that can succeed on the host
+   *     system.  For example, on non-Apple platforms the Darwin-specific
+   *     `..namedfork/rsrc` and `/rsrc` suffixes are not tried.
+   *
+   *   FT_RFORK_GUESSING_ALL ::
+   *     Try all known conventions (AppleDouble `._` files, netatalk's
+   *     `.AppleDouble` directories, and more).  This is the default.
+   *
+   * @since:
+   *   2.10.3
+   */
+  typedef enum  FT_RFork_Guessing_
+  {
+    FT_RFORK_GUESSING_NONE = 0,
+    FT_RFORK_GUESSING_NATIVE,
+    FT_RFORK_GUESSING_ALL
+
+  } FT_RFork_Guessing;
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Library_SetRForkGuessing
+   *
+   * @description:
+   *   Control the search for external resource forks, which costs several
+   *   failing file system calls each time @FT_Open_Face rejects a file
+   *   given by its path name -- something that happens quite often while
+   *   scanning font directories.
+   *
+   * @inout:
+   *   library ::
+   *     A handle to the target library object.
+   *
+   * @input:
+   *   mode ::
+   *     The guessing mode to use.
+   *
+   *   cache_misses ::
+   *     If set, remember the path names of files for which no resource
+   *     fork has been found, and don't search again if they are opened
+   *     another time.  Passing a zero value disables the cache.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   Each call to this function empties the cache of path names; call it
+   *   again after adding resource fork files to a directory that has been
+   *   scanned before.
+   *
+   *   This function has no effect if FreeType has been compiled without
+   *   Mac font support.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Library_SetRForkGuessing( FT_Library         library,
+                               FT_RFork_Guessing  mode,
+                               FT_Bool            cache_misses );
+
+
   /**************************************************************************
    *
    * @function:
@@ -73,6 +73,10 @@ FT_BEGIN_HEADER
    *   FT_Outline_ConicToFunc
    *   FT_Outline_CubicToFunc
    *
+   *   FT_Outline_Path
+   *   FT_PATH_VERB_XXX
+   *   FT_Outline_Export
+   *
    *   FT_Orientation
    *   FT_Outline_Get_Orientation
    *
@@ -125,6 +129,155 @@ FT_BEGIN_HEADER
                         void*                    user );
 
 
+  /**************************************************************************
+   *
+   * @enum:
+   *   FT_PATH_VERB_XXX
+   *
+   * @description:
+   *   A list of the path operations stored in the `verbs` array of an
+   *   @FT_Outline_Path structure.
+   *
+   * @values:
+   *   FT_PATH_VERB_MOVE_TO ::
+   *     Start a new contour.  Uses one point, the contour's start.
+   *
+   *   FT_PATH_VERB_LINE_TO ::
+   *     A line segment.  Uses one point, the end point.
+   *
+   *   FT_PATH_VERB_CONIC_TO ::
+   *     A second-order Bezier arc.  Uses two points, the control point and
+   *     the end point.
+   *
+   *   FT_PATH_VERB_CUBIC_TO ::
+   *     A third-order Bezier arc.  Uses three points, the two control points
+   *     and the end point.
+   *
+   *   FT_PATH_VERB_CLOSE ::
+   *     Close the current contour.  Uses no point.
+   *
+   * @since:
+   *   2.10.3
+   */
+#define FT_PATH_VERB_MOVE_TO   0
+#define FT_PATH_VERB_LINE_TO   1
+#define FT_PATH_VERB_CONIC_TO  2
+#define FT_PATH_VERB_CUBIC_TO  3
+#define FT_PATH_VERB_CLOSE     4
+
+
+  /**************************************************************************
+   *
+   * @struct:
+   *   FT_Outline_Path
+   *
+   * @description:
+   *   A flat representation of one or more outlines, made of an array of
+   *   path operations and an array of the points they use, in order.  It
+   *   gets filled by @FT_Outline_Export.  Both arrays are owned by the
+   *   caller.
+   *
+   * @fields:
+   *   max_verbs ::
+   *     The number of elements in the `verbs` array.
+   *
+   *   num_verbs ::
+   *     The number of path operations stored in `verbs`.
+   *
+   *   verbs ::
+   *     An array of @FT_PATH_VERB_XXX values.
+   *
+   *   max_points ::
+   *     The number of elements in the `points` array.
+   *
+   *   num_points ::
+   *     The number of points stored in `points`.
+   *
+   *   points ::
+   *     The points used by the path operations, in the units of the
+   *     exported outlines (usually 26.6 pixel coordinates).
+   *
+   * @note:
+   *   An outline with `n_points` points and `n_contours` contours never
+   *   needs more than `n_points + 2 * n_contours` verbs and `2 * n_points +
+   *   n_contours` points.
+   *
+   * @since:
+   *   2.10.3
+   */
+  typedef struct  FT_Outline_Path_
+  {
+    FT_UInt     max_verbs;
+    FT_UInt     num_verbs;
+    FT_Byte*    verbs;
+
+    FT_UInt     max_points;
+    FT_UInt     num_points;
+    FT_Vector*  points;
+
+  } FT_Outline_Path;
+
+
+  /**************************************************************************
+   *
+   * @function:
+   *   FT_Outline_Export
+   *
+   * @description:
+   *   Append one or more outlines to a flat path made of a verb array and a
+   *   point array.  This gives the same segments as @FT_Outline_Decompose,
+   *   without calling back into client code for each of them, which is
+   *   what most path renderers and GPU tessellators want as input.
+   *
+   * @input:
+   *   num_outlines ::
+   *     The number of outlines in `outlines`.
+   *
+   *   outlines ::
+   *     An array of pointers to the outlines to export.
+   *
+   *   origins ::
+   *     An optional array of `num_outlines` offsets added to the points of
+   *     the corresponding outline, in the outline's units.  Set this to
+   *     NULL to export all outlines at the origin.
+   *
+   *   matrix ::
+   *     An optional transformation applied to all points before the
+   *     offsets are added.  Set this to NULL for the identity.
+   *
+   * @inout:
+   *   path ::
+   *     The target path.  New operations and points are appended after the
+   *     first `num_verbs` and `num_points` elements of its arrays, and both
+   *     counters get updated.
+   *
+   * @return:
+   *   FreeType error code.  0~means success.
+   *
+   * @note:
+   *   Each contour starts with @FT_PATH_VERB_MOVE_TO and ends with a
+   *   segment back to its start point followed by @FT_PATH_VERB_CLOSE.  As
+   *   with @FT_Outline_Decompose, implied on-curve points between two
+   *   conic control points are made explicit.
+   *
+   *   If the arrays of `path` are too small, the function returns
+   *   `FT_Err_Array_Too_Large` and leaves `path` unchanged.  The note of
+   *   @FT_Outline_Path gives a safe size.
+   *
+   *   Coordinates are exported as integers; converting them to floating
+   *   point is a single pass over `points` without any branches.
+   *
+   * @since:
+   *   2.10.3
+   */
+  FT_EXPORT( FT_Error )
+  FT_Outline_Export( FT_UInt                   num_outlines,
+                     const FT_Outline* const*  outlines,
+                     const FT_Vector*          origins,
+                     const FT_Matrix*          matrix,
+                     FT_Outline_Path*          path );
+
+
   /**************************************************************************
    *
    * @function:
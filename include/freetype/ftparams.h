@@ -112,6 +112,44 @@ FT_BEGIN_HEADER
           FT_MAKE_TAG( 'i', 'n', 'c', 'r' )
 
 
+  /**************************************************************************
+   *
+   * @enum:
+   *   FT_PARAM_TAG_INCREMENTAL_BATCH
+   *
+   * @description:
+   *   An @FT_Parameter tag to be used with @FT_Open_Face, together with
+   *   @FT_PARAM_TAG_INCREMENTAL.  The corresponding argument is a pointer
+   *   to an @FT_Incremental_BatchFuncsRec structure.
+   *
+   * @since:
+   *   2.10.3
+   *
+   */
+#define FT_PARAM_TAG_INCREMENTAL_BATCH \
+          FT_MAKE_TAG( 'i', 'n', 'c', 'b' )
+
+
+  /**************************************************************************
+   *
+   * @enum:
+   *   FT_PARAM_TAG_MEMORY_ACCOUNTING
+   *
+   * @description:
+   *   An @FT_Parameter tag to be used with @FT_Open_Face to track the heap
+   *   memory allocated for the new face and its sizes; see
+   *   @FT_Face_GetMemoryUsage.  The corresponding argument is either NULL
+   *   or a pointer to an `FT_ULong` value holding the initial soft memory
+   *   budget in bytes (see @FT_Face_SetMemoryBudget).
+   *
+   * @since:
+   *   2.10.3
+   *
+   */
+#define FT_PARAM_TAG_MEMORY_ACCOUNTING \
+          FT_MAKE_TAG( 'm', 'e', 'm', 'a' )
+
+
   /**************************************************************************
    *
    * @enum:
@@ -405,6 +405,9 @@ FT_BEGIN_HEADER
     /* since version 2.9 */
     PS_FontExtraRec*  font_extra;
 
+    /* since version 2.10.3 */
+    FT_Hash           name_hash;    /* glyph name to index, built lazily */
+
   } CFF_FontRec;
 
 
@@ -129,6 +129,18 @@ FT_BEGIN_HEADER
   FT_GlyphLoader_CheckSubGlyphs( FT_GlyphLoader  loader,
                                  FT_UInt         n_subs );
 
+  /* preallocate room for glyphs of the given size; the values are */
+  /* capped to the limits below                                     */
+  FT_BASE( FT_Error )
+  FT_GlyphLoader_Presize( FT_GlyphLoader  loader,
+                          FT_UInt         n_points,
+                          FT_UInt         n_contours,
+                          FT_UInt         n_subglyphs );
+
+#define FT_GLYPHLOADER_PRESIZE_POINTS     4096
+#define FT_GLYPHLOADER_PRESIZE_CONTOURS   1024
+#define FT_GLYPHLOADER_PRESIZE_SUBGLYPHS  256
+
   /* prepare a glyph loader, i.e. empty the current glyph */
   FT_BASE( void )
   FT_GlyphLoader_Prepare( FT_GlyphLoader  loader );
@@ -125,6 +125,18 @@ FT_BEGIN_HEADER
   ft_hash_num_lookup( FT_Int   num,
                       FT_Hash  hash );
 
+  /* return the name of glyph `idx', or NULL */
+  typedef const char*
+  (*FT_Hash_NameFunc)( void*    data,
+                       FT_UInt  idx );
+
+  FT_Error
+  ft_hash_str_new_names( FT_Hash*          ahash,
+                         FT_UInt           count,
+                         FT_Hash_NameFunc  get_name,
+                         void*             data,
+                         FT_Memory         memory );
+
 
 FT_END_HEADER
 
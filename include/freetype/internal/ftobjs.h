@@ -35,6 +35,7 @@
 #include <freetype/internal/autohint.h>
 #include <freetype/internal/ftserv.h>
 #include <freetype/internal/ftcalc.h>
+#include <freetype/internal/fthash.h>
 
 #ifdef FT_CONFIG_OPTION_INCREMENTAL
 #include <freetype/ftincrem.h>
@@ -92,6 +93,17 @@ FT_BEGIN_HEADER
 #define FT_PIX_ROUND( x )     FT_PIX_FLOOR( (x) + 32 )
 #define FT_PIX_CEIL( x )      FT_PIX_FLOOR( (x) + 63 )
 
+  /*
+   * Truncate the fractional part of the 26.6 value `x' to one of `n'
+   * equally spaced bins and return the bin's offset in 26.6 units (that
+   * is, a value in the range [0;63]).  More than 64 bins are treated as
+   * 64, the resolution of the 26.6 format.
+   */
+#define FT_SUBPIXEL_QUANTIZE( x, n )                                \
+          ( (n) >= 64 ? (FT_Pos)( (x) & 63 )                        \
+                      : ( ( ( (FT_Pos)( (x) & 63 ) * (FT_Pos)(n) ) \
+                            >> 6 ) << 6 ) / (FT_Pos)(n) )
+
   /* specialized versions (for signed values)                   */
   /* that don't produce run-time errors due to integer overflow */
 #define FT_PAD_ROUND_LONG( x, n )  FT_PAD_FLOOR( ADD_LONG( (x), (n) / 2 ), \
@@ -333,6 +345,19 @@ FT_BEGIN_HEADER
    *     when first opened.  This field exists only if
    *     @FT_CONFIG_OPTION_INCREMENTAL is defined.
    *
+   *   incremental_batch ::
+   *     If non-null, the functions to fetch glyph data of incremental faces
+   *     in batches.  This field exists only if @FT_CONFIG_OPTION_INCREMENTAL
+   *     is defined.
+   *
+   *   incremental_num_data ::
+   *   incremental_max_data ::
+   *   incremental_data ::
+   *     The glyph data returned by the batch function but not consumed yet,
+   *     sorted by glyph index; see @FT_Incremental_Prefetch and
+   *     `ft_incremental_get_glyph_data`.  These fields exist only if
+   *     @FT_CONFIG_OPTION_INCREMENTAL is defined.
+   *
    *   no_stem_darkening ::
    *     Overrides the module-level default, see @stem-darkening[cff], for
    *     example.  FALSE and TRUE toggle stem darkening on and off,
@@ -353,7 +378,33 @@ FT_BEGIN_HEADER
    *     created.  @FT_Reference_Face increments this counter, and
    *     @FT_Done_Face only destroys a face if the counter is~1, otherwise it
    *     simply decrements it.
+   *
+   *   memory_account ::
+   *     If non-null, the memory accounting object wrapping the face's
+   *     memory manager; see @FT_PARAM_TAG_MEMORY_ACCOUNTING.  In this case,
+   *     `face->memory` and the memory of the face's own stream point to it.
+   *
+   *   list_node ::
+   *     The face's node in its driver's `faces_list`, so that @FT_Done_Face
+   *     can unlink it without searching the list.
    */
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+
+  /* an element of `FT_Face_InternalRec.incremental_data' */
+  typedef struct  FT_Incremental_DataRec_
+  {
+    FT_UInt  glyph_index;
+    FT_Data  data;
+
+  } FT_Incremental_DataRec, *FT_Incremental_Data;
+
+#endif
+
+
+  /* the memory accounting object, private to `ftobjs.c' */
+  typedef struct FT_MemAccountRec_*  FT_MemAccount;
+
+
   typedef struct  FT_Face_InternalRec_
   {
     FT_Matrix  transform_matrix;
@@ -364,6 +415,12 @@ FT_BEGIN_HEADER
 
 #ifdef FT_CONFIG_OPTION_INCREMENTAL
     FT_Incremental_InterfaceRec*  incremental_interface;
+
+    /* since version 2.10.3 */
+    FT_Incremental_BatchFuncsRec*  incremental_batch;
+    FT_UInt                        incremental_num_data;
+    FT_UInt                        incremental_max_data;
+    FT_Incremental_Data            incremental_data;
 #endif
 
     FT_Char              no_stem_darkening;
@@ -376,6 +433,10 @@ FT_BEGIN_HEADER
 
     FT_Int  refcount;
 
+    /* since version 2.10.3 */
+    FT_MemAccount  memory_account;
+    FT_ListNode    list_node;
+
   } FT_Face_InternalRec;
 
 
@@ -452,6 +513,14 @@ FT_BEGIN_HEADER
    *   autohint_metrics ::
    *     Metrics used by the auto-hinter.
    *
+   *   memory_used ::
+   *     The number of bytes attributed to this size if the parent face has
+   *     a memory accounting object.
+   *
+   *   list_node ::
+   *     The size's node in its face's `sizes_list`, so that @FT_Done_Size
+   *     can unlink it without searching the list.
+   *
    */
 
   typedef struct  FT_Size_InternalRec_
@@ -461,6 +530,9 @@ FT_BEGIN_HEADER
     FT_Render_Mode   autohint_mode;
     FT_Size_Metrics  autohint_metrics;
 
+    FT_ULong     memory_used;
+    FT_ListNode  list_node;
+
   } FT_Size_InternalRec;
 
 
@@ -719,6 +791,19 @@ FT_BEGIN_HEADER
                            FT_Byte*      buffer );
 
 
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+
+  /* Get the data of a glyph from an incremental interface, using the  */
+  /* data prefetched with `FT_Incremental_Prefetch' if available.  The */
+  /* result must be released with the interface's `free_glyph_data'.   */
+  FT_BASE( FT_Error )
+  ft_incremental_get_glyph_data( FT_Face   face,
+                                 FT_UInt   glyph_index,
+                                 FT_Data*  adata );
+
+#endif
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*************************************************************************/
@@ -889,6 +974,14 @@ FT_BEGIN_HEADER
    *     created.  @FT_Reference_Library increments this counter, and
    *     @FT_Done_Library only destroys a library if the counter is~1,
    *     otherwise it simply decrements it.
+   *
+   *   rfork_guessing ::
+   *     The resource fork guessing mode set with
+   *     @FT_Library_SetRForkGuessing.
+   *
+   *   rfork_misses ::
+   *     If non-NULL, a hash of path names for which no external resource
+   *     fork has been found.
    */
   typedef struct  FT_LibraryRec_
   {
@@ -916,6 +1009,9 @@ FT_BEGIN_HEADER
 
     FT_Int             refcount;
 
+    FT_UInt            rfork_guessing;   /* resource fork guessing   */
+    FT_Hash            rfork_misses;     /* paths without rfork      */
+
   } FT_LibraryRec;
 
 
@@ -129,6 +129,12 @@ FT_BEGIN_HEADER
    *     An array of FreeType error codes.  'errors[N]' is the error code of
    *     Nth guessing rule function.  If 'errors[N]' is not FT_Err_Ok,
    *     'new_names[N]' and 'offsets[N]' are meaningless.
+   *
+   * @note:
+   *   Rules excluded by the library's resource fork guessing mode get
+   *   error `Unimplemented_Feature`.  In mode `FT_RFORK_GUESSING_NONE`,
+   *   only the AppleSingle and AppleDouble rules run, which read `stream`
+   *   itself.
    */
   FT_BASE( void )
   FT_Raccess_Guess( FT_Library  library,
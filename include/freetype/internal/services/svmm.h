@@ -96,6 +96,11 @@ FT_BEGIN_HEADER
                                   FT_UInt*   len,
                                   FT_Fixed*  weight_vector );
 
+  typedef FT_Error
+  (*FT_Set_Size_Var_Func)( FT_Size    size,
+                           FT_UInt    num_coords,
+                           FT_Fixed*  coords );
+
 
   FT_DEFINE_SERVICE( MultiMasters )
   {
@@ -113,6 +118,10 @@ FT_BEGIN_HEADER
     /* for internal use; only needed for code sharing between modules */
     FT_Get_Var_Blend_Func  get_var_blend;
     FT_Done_Blend_Func     done_blend;
+
+    /* per-size coordinates; can be NULL */
+    FT_Set_Size_Var_Func   set_size_mm_blend;
+    FT_Set_Size_Var_Func   set_size_var_design;
   };
 
 
@@ -128,7 +137,9 @@ FT_BEGIN_HEADER
                                            set_weightvector_, \
                                            get_weightvector_, \
                                            get_var_blend_,    \
-                                           done_blend_ )      \
+                                           done_blend_,       \
+                                           set_size_blend_,   \
+                                           set_size_design_ ) \
   static const FT_Service_MultiMastersRec  class_ =           \
   {                                                           \
     get_mm_,                                                  \
@@ -142,7 +153,9 @@ FT_BEGIN_HEADER
     set_weightvector_,                                        \
     get_weightvector_,                                        \
     get_var_blend_,                                           \
-    done_blend_                                               \
+    done_blend_,                                              \
+    set_size_blend_,                                          \
+    set_size_design_                                          \
   };
 
   /* */
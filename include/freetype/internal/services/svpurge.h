@@ -0,0 +1,58 @@
+/****************************************************************************
+ *
+ * svpurge.h
+ *
+ *   The FreeType face data purging service (specification).
+ *
+ * Copyright (C) 2020 by
+ * David Turner, Robert Wilhelm, and Werner Lemberg.
+ *
+ * This file is part of the FreeType project, and may only be used,
+ * modified, and distributed under the terms of the FreeType project
+ * license, LICENSE.TXT.  By continuing to use, modify, or distribute
+ * this file you indicate that you have read the license and
+ * understand and accept it fully.
+ *
+ */
+
+
+#ifndef SVPURGE_H_
+#define SVPURGE_H_
+
+#include <freetype/internal/ftserv.h>
+
+
+FT_BEGIN_HEADER
+
+
+#define FT_SERVICE_ID_PURGE  "purge"
+
+
+  /* free face data that the driver can reconstruct on demand; */
+  /* this is called if a face exceeds its memory budget        */
+  typedef void
+  (*FT_Purge_Func)( FT_Face  face );
+
+
+  FT_DEFINE_SERVICE( Purge )
+  {
+    FT_Purge_Func  purge;
+  };
+
+
+#define FT_DEFINE_SERVICE_PURGEREC( class_, purge_ ) \
+  static const FT_Service_PurgeRec  class_ =         \
+  {                                                  \
+    purge_                                           \
+  };
+
+  /* */
+
+
+FT_END_HEADER
+
+
+#endif /* SVPURGE_H_ */
+
+
+/* END */
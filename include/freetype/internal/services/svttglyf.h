@@ -33,16 +33,27 @@ FT_BEGIN_HEADER
                               FT_UInt    gindex,
                               FT_ULong  *psize );
 
+  /* return `Unimplemented_Feature' if the glyph must be loaded instead */
+  typedef FT_Error
+  (*TT_Glyf_GetCBoxFunc)( FT_Face   face,
+                          FT_UInt   gindex,
+                          FT_Int32  load_flags,
+                          FT_BBox  *acbox );
+
   FT_DEFINE_SERVICE( TTGlyf )
   {
     TT_Glyf_GetLocationFunc  get_location;
+    TT_Glyf_GetCBoxFunc      get_cbox;
   };
 
 
-#define FT_DEFINE_SERVICE_TTGLYFREC( class_, get_location_ )  \
-  static const FT_Service_TTGlyfRec  class_ =                 \
-  {                                                           \
-    get_location_                                             \
+#define FT_DEFINE_SERVICE_TTGLYFREC( class_,                 \
+                                     get_location_,          \
+                                     get_cbox_ )             \
+  static const FT_Service_TTGlyfRec  class_ =                \
+  {                                                          \
+    get_location_,                                           \
+    get_cbox_                                                \
   };
 
   /* */
@@ -116,6 +116,7 @@ FT_BEGIN_HEADER
     FT_String**      glyph_names;       /* array of glyph names       */
     FT_Byte**        charstrings;       /* array of glyph charstrings */
     FT_UInt*         charstrings_len;
+    FT_Hash          glyph_names_hash;  /* name to index, built lazily */
 
     FT_Byte          paint_type;
     FT_Byte          font_type;
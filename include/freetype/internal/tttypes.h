@@ -23,6 +23,7 @@
 
 #include <freetype/tttables.h>
 #include <freetype/internal/ftobjs.h>
+#include <freetype/internal/fthash.h>
 #include <freetype/ftcolor.h>
 
 #ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
@@ -849,6 +850,11 @@ FT_BEGIN_HEADER
    *
    *   format_25 ::
    *     The sub-table used for format 2.5.
+   *
+   *   name_hash ::
+   *     A hash mapping glyph names to glyph indices, built on demand by
+   *     the first glyph name lookup.  Its keys point into the name strings
+   *     above.
    */
   typedef struct  TT_Post_NamesRec_
   {
@@ -861,6 +867,8 @@ FT_BEGIN_HEADER
 
     } names;
 
+    FT_Hash  name_hash;
+
   } TT_Post_NamesRec, *TT_Post_Names;
 
 
@@ -1453,6 +1461,18 @@ FT_BEGIN_HEADER
    *     This flag is set if we are in ClearType backward compatibility mode
    *     (used by the v38 implementation of the bytecode interpreter).
    *
+   *   sph_rules_compiled ::
+   *     Set if `sph_rules` and `sph_num_rules` are valid (used by the v38
+   *     implementation of the bytecode interpreter).
+   *
+   *   sph_num_rules ::
+   *     The number of entries in `sph_rules`.
+   *
+   *   sph_rules ::
+   *     The subpixel hinting tweak rules whose family and style match this
+   *     face, collected on first use (used by the v38 implementation of
+   *     the bytecode interpreter).
+   *
    *   ebdt_start ::
    *     The file offset of the sbit data table (CBDT, bdat, etc.).
    *
@@ -1632,6 +1652,12 @@ FT_BEGIN_HEADER
     FT_ULong              sph_found_func_flags; /* special functions found */
                                                 /* for this face           */
     FT_Bool               sph_compatibility_mode;
+
+    /* since 2.10.3 */
+    FT_Bool               sph_rules_compiled;
+    FT_UInt               sph_num_rules;
+    void*                 sph_rules;            /* tweak rules matching */
+                                                /* this face            */
 #endif /* TT_SUPPORT_SUBPIXEL_HINTING_INFINALITY */
 
 #ifdef TT_CONFIG_OPTION_EMBEDDED_BITMAPS
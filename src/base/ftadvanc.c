@@ -19,7 +19,10 @@
 #include <freetype/internal/ftdebug.h>
 
 #include <freetype/ftadvanc.h>
+#include <freetype/ftoutln.h>
 #include <freetype/internal/ftobjs.h>
+#include <freetype/internal/ftserv.h>
+#include <freetype/internal/services/svttglyf.h>
 
 
   static FT_Error
@@ -171,4 +174,64 @@
   }
 
 
+  /* documentation is in ftadvanc.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Get_Glyph_CBox( FT_Face   face,
+                     FT_UInt   gindex,
+                     FT_Int32  load_flags,
+                     FT_BBox  *acbox )
+  {
+    FT_Error           error;
+    FT_Service_TTGlyf  service;
+    FT_GlyphSlot       slot;
+
+
+    if ( !face )
+      return FT_THROW( Invalid_Face_Handle );
+
+    if ( !acbox )
+      return FT_THROW( Invalid_Argument );
+
+    if ( gindex >= (FT_UInt)face->num_glyphs )
+      return FT_THROW( Invalid_Glyph_Index );
+
+    FT_FACE_FIND_SERVICE( face, service, TT_GLYF );
+    if ( service && service->get_cbox )
+    {
+      error = service->get_cbox( face, gindex, load_flags, acbox );
+      if ( FT_ERR_NEQ( error, Unimplemented_Feature ) )
+        return error;
+    }
+
+    if ( load_flags & FT_ADVANCE_FLAG_FAST_ONLY )
+      return FT_THROW( Unimplemented_Feature );
+
+    load_flags &= ~( FT_ADVANCE_FLAG_FAST_ONLY |
+                     FT_LOAD_RENDER            |
+                     FT_LOAD_COLOR             );
+    load_flags |= FT_LOAD_NO_HINTING       |
+                  FT_LOAD_NO_BITMAP        |
+                  FT_LOAD_IGNORE_TRANSFORM;
+
+    error = FT_Load_Glyph( face, gindex, load_flags );
+    if ( error )
+      return error;
+
+    slot = face->glyph;
+    if ( slot->format == FT_GLYPH_FORMAT_OUTLINE )
+      FT_Outline_Get_CBox( &slot->outline, acbox );
+    else
+    {
+      /* use the metrics of whatever the driver provides */
+      acbox->xMin = slot->metrics.horiBearingX;
+      acbox->yMax = slot->metrics.horiBearingY;
+      acbox->xMax = acbox->xMin + slot->metrics.width;
+      acbox->yMin = acbox->yMax - slot->metrics.height;
+    }
+
+    return FT_Err_Ok;
+  }
+
+
 /* END */
@@ -107,17 +107,19 @@
     FT_Memory  memory = loader->memory;
 
 
+    /* the points array owns the whole outline block */
     FT_FREE( loader->base.outline.points );
-    FT_FREE( loader->base.outline.tags );
-    FT_FREE( loader->base.outline.contours );
-    FT_FREE( loader->base.extra_points );
     FT_FREE( loader->base.subglyphs );
 
-    loader->base.extra_points2 = NULL;
+    loader->base.outline.tags     = NULL;
+    loader->base.outline.contours = NULL;
+    loader->base.extra_points     = NULL;
+    loader->base.extra_points2    = NULL;
 
     loader->max_points    = 0;
     loader->max_contours  = 0;
     loader->max_subglyphs = 0;
+    loader->use_extra     = 0;
 
     FT_GlyphLoader_Rewind( loader );
   }
@@ -162,29 +164,102 @@
   }
 
 
-  FT_BASE_DEF( FT_Error )
-  FT_GlyphLoader_CreateExtra( FT_GlyphLoader  loader )
+  /* The outline tables of the loader live in a single memory block,  */
+  /* laid out as                                                      */
+  /*                                                                  */
+  /*   points        [max_points]                                     */
+  /*   extra_points  [max_points]    (only if `use_extra' is set)     */
+  /*   extra_points2 [max_points]    (only if `use_extra' is set)     */
+  /*   contours      [max_contours]                                   */
+  /*   tags          [max_points]                                     */
+  /*                                                                  */
+  /* `base.outline.points' owns the block.  Compared to separate       */
+  /* arrays this needs a single allocation when the tables grow, and  */
+  /* the data of a glyph stays close together in memory.              */
+  static FT_Error
+  ft_glyphloader_realloc_outline( FT_GlyphLoader  loader,
+                                  FT_UInt         new_max_points,
+                                  FT_UInt         new_max_contours,
+                                  FT_Bool         use_extra )
   {
-    FT_Error   error;
-    FT_Memory  memory = loader->memory;
+    FT_Memory    memory = loader->memory;
+    FT_Error     error;
+    FT_Outline*  base   = &loader->base.outline;
+    FT_UInt      old_max_points = loader->max_points;
+
+    FT_Byte*     block = NULL;
+    FT_Vector*   points;
+    FT_Vector*   extra_points;
+    FT_Short*    contours;
+    FT_Byte*     tags;
+    FT_ULong     size;
+
+
+    size = new_max_points * ( use_extra ? 3 : 1 ) * sizeof ( FT_Vector ) +
+           new_max_contours * sizeof ( FT_Short )                      +
+           new_max_points;
+
+    if ( FT_ALLOC( block, size ) )
+      goto Exit;
+
+    points       = (FT_Vector*)(void*)block;
+    extra_points = use_extra ? points + new_max_points : NULL;
+    contours     = (FT_Short*)(void*)( points +
+                                       new_max_points * ( use_extra ? 3
+                                                                    : 1 ) );
+    tags         = (FT_Byte*)( contours + new_max_contours );
+
+    if ( base->points )
+    {
+      FT_ARRAY_COPY( points,   base->points,   old_max_points );
+      FT_ARRAY_COPY( contours, base->contours, loader->max_contours );
+      FT_ARRAY_COPY( tags,     base->tags,     old_max_points );
+
+      if ( loader->use_extra && use_extra )
+      {
+        FT_ARRAY_COPY( extra_points,
+                       loader->base.extra_points,
+                       old_max_points );
+        FT_ARRAY_COPY( extra_points + new_max_points,
+                       loader->base.extra_points2,
+                       old_max_points );
+      }
 
+      FT_FREE( base->points );
+    }
 
-    if ( loader->max_points == 0           ||
-         loader->base.extra_points != NULL )
-      return FT_Err_Ok;
+    base->points   = points;
+    base->contours = contours;
+    base->tags     = (char*)tags;
 
-    if ( !FT_NEW_ARRAY( loader->base.extra_points, 2 * loader->max_points ) )
-    {
-      loader->use_extra          = 1;
-      loader->base.extra_points2 = loader->base.extra_points +
-                                   loader->max_points;
+    loader->base.extra_points  = extra_points;
+    loader->base.extra_points2 = use_extra ? extra_points + new_max_points
+                                           : NULL;
 
-      FT_GlyphLoader_Adjust_Points( loader );
-    }
+    loader->max_points   = new_max_points;
+    loader->max_contours = new_max_contours;
+    loader->use_extra    = use_extra;
+
+    FT_GlyphLoader_Adjust_Points( loader );
+
+  Exit:
     return error;
   }
 
 
+  FT_BASE_DEF( FT_Error )
+  FT_GlyphLoader_CreateExtra( FT_GlyphLoader  loader )
+  {
+    if ( loader->max_points == 0 || loader->use_extra )
+      return FT_Err_Ok;
+
+    return ft_glyphloader_realloc_outline( loader,
+                                           loader->max_points,
+                                           loader->max_contours,
+                                           1 );
+  }
+
+
   /* re-adjust the `current' subglyphs field */
   static void
   FT_GlyphLoader_Adjust_Subglyphs( FT_GlyphLoader  loader )
@@ -206,80 +281,49 @@
                               FT_UInt         n_points,
                               FT_UInt         n_contours )
   {
-    FT_Memory    memory  = loader->memory;
     FT_Error     error   = FT_Err_Ok;
     FT_Outline*  base    = &loader->base.outline;
     FT_Outline*  current = &loader->current.outline;
-    FT_Bool      adjust  = 0;
-
-    FT_UInt      new_max, old_max;
 
+    FT_UInt      new_max_points   = loader->max_points;
+    FT_UInt      new_max_contours = loader->max_contours;
+    FT_UInt      needed;
 
-    error = FT_GlyphLoader_CreateExtra( loader );
-    if ( error )
-      return error;
 
     /* check points & tags */
-    new_max = (FT_UInt)base->n_points + (FT_UInt)current->n_points +
-              n_points;
-    old_max = loader->max_points;
-
-    if ( new_max > old_max )
+    needed = (FT_UInt)base->n_points + (FT_UInt)current->n_points +
+             n_points;
+    if ( needed > new_max_points )
     {
-      new_max = FT_PAD_CEIL( new_max, 8 );
+      new_max_points = FT_PAD_CEIL( needed, 8 );
 
-      if ( new_max > FT_OUTLINE_POINTS_MAX )
+      if ( new_max_points > FT_OUTLINE_POINTS_MAX )
         return FT_THROW( Array_Too_Large );
-
-      if ( FT_RENEW_ARRAY( base->points, old_max, new_max ) ||
-           FT_RENEW_ARRAY( base->tags,   old_max, new_max ) )
-        goto Exit;
-
-      if ( loader->use_extra )
-      {
-        if ( FT_RENEW_ARRAY( loader->base.extra_points,
-                             old_max * 2, new_max * 2 ) )
-          goto Exit;
-
-        FT_ARRAY_MOVE( loader->base.extra_points + new_max,
-                       loader->base.extra_points + old_max,
-                       old_max );
-
-        loader->base.extra_points2 = loader->base.extra_points + new_max;
-      }
-
-      adjust = 1;
-      loader->max_points = new_max;
     }
 
-    error = FT_GlyphLoader_CreateExtra( loader );
-    if ( error )
-      return error;
-
     /* check contours */
-    old_max = loader->max_contours;
-    new_max = (FT_UInt)base->n_contours + (FT_UInt)current->n_contours +
-              n_contours;
-    if ( new_max > old_max )
+    needed = (FT_UInt)base->n_contours + (FT_UInt)current->n_contours +
+             n_contours;
+    if ( needed > new_max_contours )
     {
-      new_max = FT_PAD_CEIL( new_max, 4 );
+      new_max_contours = FT_PAD_CEIL( needed, 4 );
 
-      if ( new_max > FT_OUTLINE_CONTOURS_MAX )
+      if ( new_max_contours > FT_OUTLINE_CONTOURS_MAX )
         return FT_THROW( Array_Too_Large );
-
-      if ( FT_RENEW_ARRAY( base->contours, old_max, new_max ) )
-        goto Exit;
-
-      adjust = 1;
-      loader->max_contours = new_max;
     }
 
-    if ( adjust )
-      FT_GlyphLoader_Adjust_Points( loader );
-
-  Exit:
-    if ( error )
-      FT_GlyphLoader_Reset( loader );
+    /* the extra points tables are always present once we have points */
+    if ( new_max_points   != loader->max_points   ||
+         new_max_contours != loader->max_contours ||
+         ( new_max_points && !loader->use_extra ) )
+    {
+      error = ft_glyphloader_realloc_outline( loader,
+                                              new_max_points,
+                                              new_max_contours,
+                                              FT_BOOL( new_max_points ) );
+      if ( error )
+        FT_GlyphLoader_Reset( loader );
+    }
 
     return error;
   }
@@ -319,6 +363,33 @@
   }
 
 
+  /* Preallocate the tables of a fresh loader for glyphs with up to      */
+  /* `n_points' points, `n_contours' contours, and `n_subglyphs'          */
+  /* subglyphs.  Drivers pass maxima from the font (for example, from the */
+  /* `maxp' table) so that the tables need not grow while glyphs are      */
+  /* loaded.  Since such values can't be trusted, they are capped; the    */
+  /* tables still grow on demand if necessary.                            */
+  FT_BASE_DEF( FT_Error )
+  FT_GlyphLoader_Presize( FT_GlyphLoader  loader,
+                          FT_UInt         n_points,
+                          FT_UInt         n_contours,
+                          FT_UInt         n_subglyphs )
+  {
+    FT_Error  error;
+
+
+    n_points    = FT_MIN( n_points,    FT_GLYPHLOADER_PRESIZE_POINTS );
+    n_contours  = FT_MIN( n_contours,  FT_GLYPHLOADER_PRESIZE_CONTOURS );
+    n_subglyphs = FT_MIN( n_subglyphs, FT_GLYPHLOADER_PRESIZE_SUBGLYPHS );
+
+    error = FT_GlyphLoader_CheckPoints( loader, n_points, n_contours );
+    if ( !error )
+      error = FT_GlyphLoader_CheckSubGlyphs( loader, n_subglyphs );
+
+    return error;
+  }
+
+
   /* prepare loader for the addition of a new glyph on top of the base one */
   FT_BASE_DEF( void )
   FT_GlyphLoader_Prepare( FT_GlyphLoader  loader )
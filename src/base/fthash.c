@@ -335,4 +335,54 @@
   }
 
 
+  /* Allocate a hash that maps the names of glyphs 0 to `count'-1 to   */
+  /* their indices.  If `get_name' is NULL, `data' is an array of      */
+  /* `count' strings.  If several glyphs share a name, the smallest    */
+  /* glyph index wins, as with a linear search.                        */
+  FT_Error
+  ft_hash_str_new_names( FT_Hash*          ahash,
+                         FT_UInt           count,
+                         FT_Hash_NameFunc  get_name,
+                         void*             data,
+                         FT_Memory         memory )
+  {
+    FT_Hash   hash = NULL;
+    FT_Error  error;
+
+    FT_UInt  i;
+
+
+    if ( FT_NEW( hash ) )
+      goto Exit;
+
+    error = ft_hash_str_init( hash, memory );
+    if ( error )
+      goto Fail;
+
+    for ( i = 0; i < count; i++ )
+    {
+      const char*  name = get_name ? get_name( data, i )
+                                   : ( (const char**)data )[i];
+
+
+      if ( !name || ft_hash_str_lookup( name, hash ) )
+        continue;
+
+      error = ft_hash_str_insert( name, i, hash, memory );
+      if ( error )
+        goto Fail;
+    }
+
+    *ahash = hash;
+
+  Exit:
+    return error;
+
+  Fail:
+    ft_hash_str_free( hash, memory );
+    FT_FREE( hash );
+    goto Exit;
+  }
+
+
 /* END */
@@ -565,4 +565,62 @@
   }
 
 
+  /* documentation is in ftmm.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Set_Size_Var_Design_Coordinates( FT_Size    size,
+                                      FT_UInt    num_coords,
+                                      FT_Fixed*  coords )
+  {
+    FT_Error                 error;
+    FT_Service_MultiMasters  service;
+
+
+    if ( !size )
+      return FT_THROW( Invalid_Size_Handle );
+
+    if ( num_coords && !coords )
+      return FT_THROW( Invalid_Argument );
+
+    error = ft_face_get_mm_service( size->face, &service );
+    if ( !error )
+    {
+      error = FT_ERR( Invalid_Argument );
+      if ( service->set_size_var_design )
+        error = service->set_size_var_design( size, num_coords, coords );
+    }
+
+    return error;
+  }
+
+
+  /* documentation is in ftmm.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Set_Size_Var_Blend_Coordinates( FT_Size    size,
+                                     FT_UInt    num_coords,
+                                     FT_Fixed*  coords )
+  {
+    FT_Error                 error;
+    FT_Service_MultiMasters  service;
+
+
+    if ( !size )
+      return FT_THROW( Invalid_Size_Handle );
+
+    if ( num_coords && !coords )
+      return FT_THROW( Invalid_Argument );
+
+    error = ft_face_get_mm_service( size->face, &service );
+    if ( !error )
+    {
+      error = FT_ERR( Invalid_Argument );
+      if ( service->set_size_mm_blend )
+        error = service->set_size_mm_blend( size, num_coords, coords );
+    }
+
+    return error;
+  }
+
+
 /* END */
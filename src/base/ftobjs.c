@@ -39,6 +39,7 @@
 #include <freetype/internal/services/svttcmap.h>
 #include <freetype/internal/services/svkern.h>
 #include <freetype/internal/services/svtteng.h>
+#include <freetype/internal/services/svpurge.h>
 
 #include <freetype/ftdriver.h>
 
@@ -280,6 +281,388 @@
 #define FT_COMPONENT  objs
 
 
+  /*************************************************************************/
+  /*************************************************************************/
+  /*************************************************************************/
+  /****                                                                 ****/
+  /****                                                                 ****/
+  /****                  M E M O R Y   A C C O U N T I N G              ****/
+  /****                                                                 ****/
+  /****                                                                 ****/
+  /*************************************************************************/
+  /*************************************************************************/
+  /*************************************************************************/
+
+  /*
+   * A face opened with `FT_PARAM_TAG_MEMORY_ACCOUNTING' gets its own
+   * memory object, which forwards all requests to the driver's memory
+   * manager and records the size and owner of every live block in an
+   * open-addressing hash table keyed by the block address.  Blocks not
+   * found in the table are simply passed through; this makes it harmless
+   * if a block allocated with the face's memory object gets freed with the
+   * library's one, or vice versa.
+   */
+
+  typedef struct  FT_MemAccountNodeRec_
+  {
+    void*     block;
+    FT_ULong  size;
+    FT_Size   owner;   /* NULL for face data */
+
+  } FT_MemAccountNodeRec, *FT_MemAccountNode;
+
+
+  typedef struct  FT_MemAccountRec_
+  {
+    struct FT_MemoryRec_  root;          /* must be first */
+    FT_Memory             base;
+
+    FT_ULong              used;
+    FT_ULong              max_used;
+    FT_ULong              budget;
+    FT_Bool               over_budget;
+
+    FT_Size               owner;         /* owner of new blocks          */
+    FT_UInt               load_depth;    /* nesting of `FT_Load_Glyph'   */
+
+    FT_ULong              num_nodes;
+    FT_ULong              max_nodes;     /* a power of 2, or zero        */
+    FT_MemAccountNode     nodes;
+
+  } FT_MemAccountRec;
+
+
+#define FT_MEM_ACCOUNT_MIN_NODES  256
+
+  /* heap blocks are aligned, so the lowest bits carry no information */
+#define FT_MEM_ACCOUNT_HASH( block, mask )                   \
+          ( ( ( (FT_Offset)(block) >> 4 ) ^                  \
+              ( (FT_Offset)(block) >> 12 ) ) & (FT_Offset)(mask) )
+
+
+  static FT_MemAccountNode
+  ft_mem_account_find( FT_MemAccount  account,
+                       void*          block )
+  {
+    FT_MemAccountNode  nodes = account->nodes;
+    FT_ULong           mask  = account->max_nodes - 1;
+    FT_ULong           idx;
+
+
+    if ( !nodes )
+      return NULL;
+
+    idx = FT_MEM_ACCOUNT_HASH( block, mask );
+    while ( nodes[idx].block )
+    {
+      if ( nodes[idx].block == block )
+        return nodes + idx;
+
+      idx = ( idx + 1 ) & mask;
+    }
+
+    return NULL;
+  }
+
+
+  static void
+  ft_mem_account_remove( FT_MemAccount      account,
+                         FT_MemAccountNode  node )
+  {
+    FT_MemAccountNode  nodes = account->nodes;
+    FT_ULong           mask  = account->max_nodes - 1;
+    FT_ULong           hole  = (FT_ULong)( node - nodes );
+    FT_ULong           idx   = hole;
+
+
+    account->used -= node->size;
+    if ( node->owner )
+      node->owner->internal->memory_used -= node->size;
+
+    /* close the gap by moving back entries of the same probe sequence */
+    for (;;)
+    {
+      FT_ULong  home;
+
+
+      idx = ( idx + 1 ) & mask;
+      if ( !nodes[idx].block )
+        break;
+
+      home = FT_MEM_ACCOUNT_HASH( nodes[idx].block, mask );
+
+      /* move the entry unless its home lies cyclically in ]hole,idx] */
+      if ( idx > hole ? ( home <= hole || home > idx )
+                      : ( home <= hole && home > idx ) )
+      {
+        nodes[hole] = nodes[idx];
+        hole        = idx;
+      }
+    }
+
+    nodes[hole].block = NULL;
+    nodes[hole].size  = 0;
+    nodes[hole].owner = NULL;
+
+    account->num_nodes--;
+  }
+
+
+  static FT_Error
+  ft_mem_account_grow( FT_MemAccount  account )
+  {
+    FT_Memory          memory    = account->base;
+    FT_MemAccountNode  old_nodes = account->nodes;
+    FT_ULong           old_max   = account->max_nodes;
+    FT_MemAccountNode  nodes     = NULL;
+    FT_ULong           max_nodes, mask, n;
+    FT_Error           error;
+
+
+    max_nodes = old_max ? 2 * old_max : FT_MEM_ACCOUNT_MIN_NODES;
+    mask      = max_nodes - 1;
+
+    if ( FT_NEW_ARRAY( nodes, max_nodes ) )
+      return error;
+
+    for ( n = 0; n < old_max; n++ )
+    {
+      FT_ULong  idx;
+
+
+      if ( !old_nodes[n].block )
+        continue;
+
+      idx = FT_MEM_ACCOUNT_HASH( old_nodes[n].block, mask );
+      while ( nodes[idx].block )
+        idx = ( idx + 1 ) & mask;
+
+      nodes[idx] = old_nodes[n];
+    }
+
+    FT_FREE( old_nodes );
+
+    account->nodes     = nodes;
+    account->max_nodes = max_nodes;
+
+    return FT_Err_Ok;
+  }
+
+
+  static void
+  ft_mem_account_add( FT_MemAccount  account,
+                      void*          block,
+                      FT_ULong       size,
+                      FT_Size        owner )
+  {
+    FT_MemAccountNode  node;
+    FT_ULong           mask, idx;
+
+
+    /* a stale entry for a block freed through another memory object */
+    node = ft_mem_account_find( account, block );
+    if ( node )
+      ft_mem_account_remove( account, node );
+
+    /* keep the load factor below 1/2; */
+    /* without memory the block simply stays untracked */
+    if ( 2 * ( account->num_nodes + 1 ) > account->max_nodes &&
+         ft_mem_account_grow( account )                      )
+      return;
+
+    mask = account->max_nodes - 1;
+    idx  = FT_MEM_ACCOUNT_HASH( block, mask );
+    while ( account->nodes[idx].block )
+      idx = ( idx + 1 ) & mask;
+
+    node        = account->nodes + idx;
+    node->block = block;
+    node->size  = size;
+    node->owner = owner;
+
+    account->num_nodes++;
+
+    account->used += size;
+    if ( account->used > account->max_used )
+      account->max_used = account->used;
+    if ( account->budget && account->used > account->budget )
+      account->over_budget = TRUE;
+
+    if ( owner )
+      owner->internal->memory_used += size;
+  }
+
+
+  FT_CALLBACK_DEF( void* )
+  ft_mem_account_alloc( FT_Memory  memory,
+                        long       size )
+  {
+    FT_MemAccount  account = (FT_MemAccount)memory;
+    FT_Memory      base    = account->base;
+    void*          block;
+
+
+    block = base->alloc( base, size );
+    if ( block )
+      ft_mem_account_add( account, block, (FT_ULong)size, account->owner );
+
+    return block;
+  }
+
+
+  FT_CALLBACK_DEF( void* )
+  ft_mem_account_realloc( FT_Memory  memory,
+                          long       cur_size,
+                          long       new_size,
+                          void*      block )
+  {
+    FT_MemAccount      account = (FT_MemAccount)memory;
+    FT_Memory          base    = account->base;
+    FT_MemAccountNode  node;
+    FT_Size            owner   = account->owner;
+    FT_ULong           size    = 0;
+    void*              new_block;
+
+
+    node = ft_mem_account_find( account, block );
+    if ( node )
+    {
+      owner = node->owner;
+      size  = node->size;
+      ft_mem_account_remove( account, node );
+    }
+
+    new_block = base->realloc( base, cur_size, new_size, block );
+    if ( new_block )
+      ft_mem_account_add( account, new_block, (FT_ULong)new_size, owner );
+    else if ( node )
+      ft_mem_account_add( account, block, size, owner );
+
+    return new_block;
+  }
+
+
+  FT_CALLBACK_DEF( void )
+  ft_mem_account_free( FT_Memory  memory,
+                       void*      block )
+  {
+    FT_MemAccount      account = (FT_MemAccount)memory;
+    FT_Memory          base    = account->base;
+    FT_MemAccountNode  node;
+
+
+    node = ft_mem_account_find( account, block );
+    if ( node )
+      ft_mem_account_remove( account, node );
+
+    base->free( base, block );
+  }
+
+
+  static FT_Error
+  ft_mem_account_new( FT_Memory       memory,
+                      FT_ULong        budget,
+                      FT_MemAccount  *aaccount )
+  {
+    FT_MemAccount  account = NULL;
+    FT_Error       error;
+
+
+    if ( FT_NEW( account ) )
+      goto Exit;
+
+    account->root.user    = NULL;
+    account->root.alloc   = ft_mem_account_alloc;
+    account->root.free    = ft_mem_account_free;
+    account->root.realloc = ft_mem_account_realloc;
+
+    account->base   = memory;
+    account->budget = budget;
+
+  Exit:
+    *aaccount = account;
+    return error;
+  }
+
+
+  static void
+  ft_mem_account_done( FT_MemAccount  account )
+  {
+    FT_Memory  memory = account->base;
+
+
+    FT_FREE( account->nodes );
+    FT_FREE( account );
+  }
+
+
+  /* attribute new blocks of `face' to `owner'; return the old owner */
+  static FT_Size
+  ft_mem_account_set_owner( FT_Face  face,
+                            FT_Size  owner )
+  {
+    FT_MemAccount  account = face->internal->memory_account;
+    FT_Size        old     = NULL;
+
+
+    if ( account )
+    {
+      old            = account->owner;
+      account->owner = owner;
+    }
+
+    return old;
+  }
+
+
+  /* detach all blocks from a size object that is about to go away */
+  static void
+  ft_mem_account_forget_size( FT_MemAccount  account,
+                              FT_Size        size )
+  {
+    FT_ULong  n;
+
+
+    for ( n = 0; n < account->max_nodes; n++ )
+    {
+      if ( account->nodes[n].owner == size )
+        account->nodes[n].owner = NULL;
+    }
+
+    size->internal->memory_used = 0;
+  }
+
+
+  /* release face data that can be reconstructed on demand */
+  static void
+  ft_face_purge( FT_Face  face )
+  {
+    FT_MemAccount     account = face->internal->memory_account;
+    FT_Service_Purge  service;
+
+
+    FT_TRACE3(( "ft_face_purge: %lu bytes in use, budget is %lu\n",
+                account->used, account->budget ));
+
+    /* the auto-hinter rebuilds its global metrics if they are missing */
+    if ( face->autohint.finalizer )
+    {
+      face->autohint.finalizer( face->autohint.data );
+
+      face->autohint.data      = NULL;
+      face->autohint.finalizer = NULL;
+    }
+
+    FT_FACE_FIND_SERVICE( face, service, PURGE );
+    if ( service && service->purge )
+      service->purge( face );
+
+    account->over_budget = FALSE;
+
+    FT_TRACE3(( "ft_face_purge: %lu bytes left\n", account->used ));
+  }
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*************************************************************************/
@@ -805,6 +1188,9 @@
     FT_Module     hinter;
     TT_Face       ttface = (TT_Face)face;
 
+    FT_MemAccount  account;
+    FT_Size        owner = NULL;
+
 
     if ( !face || !face->size || !face->glyph )
       return FT_THROW( Invalid_Face_Handle );
@@ -815,6 +1201,15 @@
     slot = face->glyph;
     ft_glyphslot_clear( slot );
 
+    /* data allocated while loading belongs to the active size */
+    account = face->internal->memory_account;
+    if ( account )
+    {
+      owner          = account->owner;
+      account->owner = face->size;
+      account->load_depth++;
+    }
+
     driver  = face->driver;
     library = driver->root.library;
     hinter  = library->auto_hinter;
@@ -969,6 +1364,10 @@
     }
 
   Load_Ok:
+    /* but the rendered glyph image belongs to the slot */
+    if ( account )
+      account->owner = owner;
+
     /* compute the advance */
     if ( load_flags & FT_LOAD_VERTICAL_LAYOUT )
     {
@@ -1070,6 +1469,15 @@
 #endif
 
   Exit:
+    if ( account )
+    {
+      account->owner = owner;
+
+      /* the auto-hinter calls `FT_Load_Glyph' recursively */
+      if ( --account->load_depth == 0 && account->over_budget )
+        ft_face_purge( face );
+    }
+
     return error;
   }
 
@@ -1109,6 +1517,10 @@
     if ( driver->clazz->done_size )
       driver->clazz->done_size( size );
 
+    if ( size->face->internal->memory_account )
+      ft_mem_account_forget_size( size->face->internal->memory_account,
+                                  size );
+
     FT_FREE( size->internal );
     FT_FREE( size );
   }
@@ -1143,6 +1555,236 @@
   }
 
 
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+
+  /* ft_qsort callback to sort glyph indices; also used for arrays of */
+  /* `FT_Incremental_DataRec', whose first field is the glyph index   */
+  FT_CALLBACK_DEF( int )
+  ft_incremental_compare( const void*  a,
+                          const void*  b )
+  {
+    FT_UInt  index1 = *(const FT_UInt*)a;
+    FT_UInt  index2 = *(const FT_UInt*)b;
+
+
+    if ( index1 > index2 )
+      return 1;
+    else if ( index1 < index2 )
+      return -1;
+    else
+      return 0;
+  }
+
+
+  /* binary search in the prefetched glyph data */
+  static FT_Incremental_Data
+  ft_incremental_find( FT_Face_Internal  internal,
+                       FT_UInt           glyph_index )
+  {
+    FT_UInt  min = 0;
+    FT_UInt  max = internal->incremental_num_data;
+
+
+    while ( min < max )
+    {
+      FT_UInt              mid   = ( min + max ) >> 1;
+      FT_Incremental_Data  entry = internal->incremental_data + mid;
+
+
+      if ( entry->glyph_index == glyph_index )
+        return entry;
+
+      if ( entry->glyph_index < glyph_index )
+        min = mid + 1;
+      else
+        max = mid;
+    }
+
+    return NULL;
+  }
+
+
+  /* release prefetched glyph data that never got used */
+  static void
+  ft_incremental_done( FT_Face  face )
+  {
+    FT_Memory         memory   = face->memory;
+    FT_Face_Internal  internal = face->internal;
+    FT_UInt           n;
+
+
+    for ( n = 0; n < internal->incremental_num_data; n++ )
+      internal->incremental_interface->funcs->free_glyph_data(
+        internal->incremental_interface->object,
+        &internal->incremental_data[n].data );
+
+    FT_FREE( internal->incremental_data );
+    internal->incremental_num_data = 0;
+    internal->incremental_max_data = 0;
+  }
+
+
+  /* documentation is in ftobjs.h */
+
+  FT_BASE_DEF( FT_Error )
+  ft_incremental_get_glyph_data( FT_Face   face,
+                                 FT_UInt   glyph_index,
+                                 FT_Data*  adata )
+  {
+    FT_Face_Internal     internal = face->internal;
+    FT_Incremental_Data  entry;
+
+
+    entry = ft_incremental_find( internal, glyph_index );
+    if ( entry )
+    {
+      FT_Incremental_Data  limit = internal->incremental_data +
+                                   internal->incremental_num_data;
+
+
+      /* the caller takes over the data */
+      *adata = entry->data;
+
+      ft_memmove( entry,
+                  entry + 1,
+                  (FT_Offset)( limit - entry - 1 ) * sizeof ( *entry ) );
+      internal->incremental_num_data--;
+
+      return FT_Err_Ok;
+    }
+
+    return internal->incremental_interface->funcs->get_glyph_data(
+             internal->incremental_interface->object,
+             glyph_index,
+             adata );
+  }
+
+
+  /* documentation is in ftincrem.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Incremental_Prefetch( FT_Face         face,
+                           FT_UInt         num_glyphs,
+                           const FT_UInt*  glyph_indices )
+  {
+    FT_Error          error = FT_Err_Ok;
+    FT_Memory         memory;
+    FT_Face_Internal  internal;
+
+    FT_UInt*  indices = NULL;
+    FT_Data*  data    = NULL;
+    FT_UInt   count, n;
+
+
+    if ( !face )
+      return FT_THROW( Invalid_Face_Handle );
+
+    if ( num_glyphs && !glyph_indices )
+      return FT_THROW( Invalid_Argument );
+
+    internal = face->internal;
+    if ( !internal->incremental_interface ||
+         !internal->incremental_batch     ||
+         !num_glyphs                      )
+      return FT_Err_Ok;
+
+    memory = face->memory;
+
+    if ( FT_QNEW_ARRAY( indices, num_glyphs ) )
+      goto Exit;
+
+    ft_memcpy( indices, glyph_indices, num_glyphs * sizeof ( FT_UInt ) );
+    ft_qsort( indices, num_glyphs, sizeof ( FT_UInt ),
+              ft_incremental_compare );
+
+    /* drop duplicates and glyphs whose data we already have */
+    count = 0;
+    for ( n = 0; n < num_glyphs; n++ )
+    {
+      if ( count && indices[count - 1] == indices[n] )
+        continue;
+
+      if ( ft_incremental_find( internal, indices[n] ) )
+        continue;
+
+      indices[count++] = indices[n];
+    }
+
+    if ( !count )
+      goto Exit;
+
+    if ( internal->incremental_num_data + count >
+           internal->incremental_max_data       )
+    {
+      FT_UInt  new_max = internal->incremental_num_data + count;
+
+
+      if ( FT_RENEW_ARRAY( internal->incremental_data,
+                           internal->incremental_max_data,
+                           new_max ) )
+        goto Exit;
+
+      internal->incremental_max_data = new_max;
+    }
+
+    if ( FT_NEW_ARRAY( data, count ) )
+      goto Exit;
+
+    error = internal->incremental_batch->get_glyph_data_batch(
+              internal->incremental_interface->object,
+              count,
+              indices,
+              data );
+    if ( error )
+      goto Exit;
+
+    for ( n = 0; n < count; n++ )
+    {
+      FT_Incremental_Data  entry;
+
+
+      if ( !data[n].pointer )
+        continue;
+
+      entry = internal->incremental_data + internal->incremental_num_data++;
+
+      entry->glyph_index = indices[n];
+      entry->data        = data[n];
+    }
+
+    ft_qsort( internal->incremental_data,
+              internal->incremental_num_data,
+              sizeof ( FT_Incremental_DataRec ),
+              ft_incremental_compare );
+
+  Exit:
+    FT_FREE( data );
+    FT_FREE( indices );
+
+    return error;
+  }
+
+#else /* !FT_CONFIG_OPTION_INCREMENTAL */
+
+  /* documentation is in ftincrem.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Incremental_Prefetch( FT_Face         face,
+                           FT_UInt         num_glyphs,
+                           const FT_UInt*  glyph_indices )
+  {
+    FT_UNUSED( num_glyphs );
+    FT_UNUSED( glyph_indices );
+
+    if ( !face )
+      return FT_THROW( Invalid_Face_Handle );
+
+    return FT_Err_Ok;
+  }
+
+#endif /* !FT_CONFIG_OPTION_INCREMENTAL */
+
+
   /* destructor for faces list */
   static void
   destroy_face( FT_Memory  memory,
@@ -1175,6 +1817,11 @@
     /* discard charmaps */
     destroy_charmaps( face, memory );
 
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+    if ( face->internal && face->internal->incremental_interface )
+      ft_incremental_done( face );
+#endif
+
     /* finalize format-specific stuff */
     if ( clazz->done_face )
       clazz->done_face( face );
@@ -1189,6 +1836,11 @@
     /* get rid of it */
     if ( face->internal )
     {
+      if ( face->internal->memory_account )
+      {
+        ft_mem_account_done( face->internal->memory_account );
+      }
+
       FT_FREE( face->internal );
     }
     FT_FREE( face );
@@ -1393,11 +2045,45 @@
         if ( params[i].tag == FT_PARAM_TAG_INCREMENTAL )
           face->internal->incremental_interface =
             (FT_Incremental_Interface)params[i].data;
+
+      face->internal->incremental_batch = NULL;
+      for ( i = 0; i < num_params && !face->internal->incremental_batch;
+            i++ )
+        if ( params[i].tag == FT_PARAM_TAG_INCREMENTAL_BATCH )
+          face->internal->incremental_batch =
+            (FT_Incremental_BatchFuncsRec*)params[i].data;
     }
 #endif
 
     face->internal->random_seed = -1;
 
+    {
+      int  i;
+
+
+      for ( i = 0; i < num_params; i++ )
+      {
+        if ( params[i].tag == FT_PARAM_TAG_MEMORY_ACCOUNTING )
+        {
+          FT_ULong*  budget = (FT_ULong*)params[i].data;
+
+
+          error = ft_mem_account_new( memory,
+                                      budget ? *budget : 0,
+                                      &internal->memory_account );
+          if ( error )
+            goto Fail;
+
+          /* tables extracted from the font file count, too */
+          face->memory = (FT_Memory)internal->memory_account;
+          if ( !external_stream )
+            (*astream)->memory = face->memory;
+
+          break;
+        }
+      }
+    }
+
     if ( clazz->init_face )
       error = clazz->init_face( *astream,
                                 face,
@@ -1429,6 +2115,16 @@
       destroy_charmaps( face, memory );
       if ( clazz->done_face )
         clazz->done_face( face );
+
+      /* the stream gets reused for the next driver */
+      if ( internal && internal->memory_account )
+      {
+        if ( *astream && (*astream)->memory == face->memory )
+          (*astream)->memory = memory;
+
+        ft_mem_account_done( internal->memory_account );
+      }
+
       FT_FREE( internal );
       FT_FREE( face );
       *aface = NULL;
@@ -2210,6 +2906,78 @@
   }
 
 
+  /* The maximum number of path names in the cache of failed resource */
+  /* fork searches; the cache gets emptied if it is full.             */
+#define FT_RFORK_MISSES_MAX  4096
+
+
+  static void
+  ft_rfork_misses_reset( FT_Library  library,
+                         FT_Bool     enable )
+  {
+    FT_Memory  memory = library->memory;
+    FT_Hash    misses = library->rfork_misses;
+    FT_Error   error;
+
+
+    if ( misses )
+    {
+      FT_Hashnode*  bp = misses->table;
+      FT_UInt       i;
+
+
+      /* the keys are our own copies of the path names */
+      for ( i = 0; i < misses->size; i++, bp++ )
+        if ( *bp )
+          FT_FREE( (*bp)->key.str );
+
+      ft_hash_str_free( misses, memory );
+      FT_FREE( library->rfork_misses );
+    }
+
+    if ( !enable )
+      return;
+
+    if ( FT_QNEW( library->rfork_misses ) )
+      return;
+
+    if ( ft_hash_str_init( library->rfork_misses, memory ) )
+      FT_FREE( library->rfork_misses );
+  }
+
+
+  static void
+  ft_rfork_misses_add( FT_Library   library,
+                       const char*  pathname )
+  {
+    FT_Memory  memory = library->memory;
+    FT_Hash    misses = library->rfork_misses;
+    FT_ULong   len    = ft_strlen( pathname ) + 1;
+    char*      key    = NULL;
+    FT_Error   error;
+
+
+    if ( misses->used >= FT_RFORK_MISSES_MAX )
+    {
+      ft_rfork_misses_reset( library, TRUE );
+
+      misses = library->rfork_misses;
+      if ( !misses )
+        return;
+    }
+
+    /* the cache is only an optimization, so errors are ignored */
+    if ( FT_QALLOC( key, len ) )
+      return;
+
+    FT_MEM_COPY( key, pathname, len );
+
+    if ( ft_hash_str_insert( key, 1, misses, memory ) &&
+         !ft_hash_str_lookup( key, misses )           )
+      FT_FREE( key );
+  }
+
+
   static FT_Error
   load_face_in_embedded_rfork( FT_Library           library,
                                FT_Stream            stream,
@@ -2233,12 +3001,25 @@
     FT_Open_Args  args2;
     FT_Stream     stream2 = NULL;
 
+    FT_Bool       cache_miss = TRUE;
+
+
+    if ( library->rfork_misses                                     &&
+         ft_hash_str_lookup( args->pathname, library->rfork_misses ) )
+    {
+      FT_TRACE3(( "No resource fork for %s (cached)\n", args->pathname ));
+      return FT_ERR( Unknown_File_Format );
+    }
 
     FT_Raccess_Guess( library, stream,
                       args->pathname, file_names, offsets, errors );
 
     for ( i = 0; i < FT_RACCESS_N_RULES; i++ )
     {
+      /* don't remember a miss caused by a lack of memory */
+      if ( FT_ERR_EQ( errors[i], Out_Of_Memory ) )
+        cache_miss = FALSE;
+
       is_darwin_vfs = ft_raccess_rule_by_darwin_vfs( library, i );
       if ( is_darwin_vfs && vfs_rfork_has_no_font )
       {
@@ -2278,6 +3059,9 @@
 
       FT_TRACE3(( "%s\n", error ? "failed": "successful" ));
 
+      if ( FT_ERR_EQ( error, Out_Of_Memory ) )
+        cache_miss = FALSE;
+
       if ( !error )
           break;
       else if ( is_darwin_vfs )
@@ -2292,7 +3076,12 @@
 
     /* Caller (load_mac_face) requires FT_Err_Unknown_File_Format. */
     if ( error )
+    {
+      if ( library->rfork_misses && cache_miss )
+        ft_rfork_misses_add( library, args->pathname );
+
       error = FT_ERR( Unknown_File_Format );
+    }
 
     return error;
 
@@ -2340,29 +3129,123 @@
 #undef  FT_COMPONENT
 #define FT_COMPONENT  objs
 
-    }
+    }
+
+    if ( ( FT_ERR_EQ( error, Unknown_File_Format )       ||
+           FT_ERR_EQ( error, Invalid_Stream_Operation ) )  &&
+         ( args->flags & FT_OPEN_PATHNAME )                )
+      error = load_face_in_embedded_rfork( library, stream,
+                                           face_index, aface, args );
+    return error;
+  }
+#endif
+
+#endif  /* !FT_MACINTOSH && FT_CONFIG_OPTION_MAC_FONTS */
+
+
+  /* documentation is in freetype.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Open_Face( FT_Library           library,
+                const FT_Open_Args*  args,
+                FT_Long              face_index,
+                FT_Face             *aface )
+  {
+    return ft_open_face_internal( library, args, face_index, aface, 1 );
+  }
+
+
+  /* Font file signatures, most specific first.  A match only selects */
+  /* the driver to try first; all others are still tried in the usual */
+  /* order if it doesn't accept the file.                              */
+
+  typedef struct  FT_Font_SignatureRec_
+  {
+    const char*  magic;
+    FT_UInt      length;
+    const char*  driver_name;
+
+  } FT_Font_SignatureRec;
+
+
+  static const FT_Font_SignatureRec  ft_font_signatures[] =
+  {
+    /* WOFF and WOFF2 containers always go to the `truetype' driver; */
+    /* for CFF-based fonts, its probe unwraps them for the `cff' one  */
+    { "wOFF",                             4, "truetype" },
+    { "wOF2",                             4, "truetype" },
+
+    { "\0\1\0\0",                         4, "truetype" },
+    { "true",                             4, "truetype" },
+    { "ttcf",                             4, "truetype" },
+    { "OTTO",                             4, "cff"      },
+    { "\1\0\4",                           3, "cff"      },  /* bare CFF  */
+    { "\2\0\5",                           3, "cff"      },  /* bare CFF2 */
+
+    { "%!PS-Adobe-3.0 Resource-CIDFont", 31, "t1cid"    },
+    { "%!PS-TrueTypeFont",               17, "type42"   },
+    { "%!PS-AdobeFont",                  14, "type1"    },
+    { "%!FontType",                      10, "type1"    },
+    { "\x80\1",                           2, "type1"    },  /* PFB */
+
+    { "PFR0",                             4, "pfr"      },
+    { "STARTFONT",                        9, "bdf"      },
+
+    /* the PCF driver also handles compressed files */
+    { "\1fcp",                            4, "pcf"      },
+    { "\x1F\x8B",                         2, "pcf"      },  /* gzip  */
+    { "\x1F\x9D",                         2, "pcf"      },  /* LZW   */
+    { "BZh",                              3, "pcf"      },  /* bzip2 */
+
+    { "MZ",                               2, "winfnt"   }
+  };
+
+
+  /* Return the driver matching the first bytes of `stream', if any. */
+  /* The stream position is left unchanged.                          */
+  static FT_Module
+  ft_open_face_sniff( FT_Library  library,
+                      FT_Stream   stream )
+  {
+    FT_Byte    header[32];
+    FT_ULong   pos = FT_Stream_Pos( stream );
+    FT_ULong   len;
+    FT_UInt    n;
+    FT_Module  module = NULL;
+
+
+    len = stream->size > pos ? stream->size - pos : 0;
+    if ( len > sizeof ( header ) )
+      len = sizeof ( header );
+
+    if ( len < 2 || FT_Stream_ReadAt( stream, pos, header, len ) )
+      goto Exit;
+
+    for ( n = 0; n < sizeof ( ft_font_signatures ) /
+                       sizeof ( ft_font_signatures[0] ); n++ )
+    {
+      const FT_Font_SignatureRec*  sig = ft_font_signatures + n;
 
-    if ( ( FT_ERR_EQ( error, Unknown_File_Format )      ||
-           FT_ERR_EQ( error, Invalid_Stream_Operation ) ) &&
-         ( args->flags & FT_OPEN_PATHNAME )               )
-      error = load_face_in_embedded_rfork( library, stream,
-                                           face_index, aface, args );
-    return error;
-  }
-#endif
 
-#endif  /* !FT_MACINTOSH && FT_CONFIG_OPTION_MAC_FONTS */
+      if ( sig->length <= len                           &&
+           !ft_memcmp( header, sig->magic, sig->length ) )
+      {
+        module = FT_Get_Module( library, sig->driver_name );
+        if ( module && !FT_MODULE_IS_DRIVER( module ) )
+          module = NULL;
 
+        FT_TRACE3(( "ft_open_face_sniff: signature of `%s' driver%s\n",
+                    sig->driver_name, module ? "" : " (not available)" ));
+        break;
+      }
+    }
 
-  /* documentation is in freetype.h */
+  Exit:
+    /* the first driver expects the stream at its original position */
+    if ( FT_Stream_Seek( stream, pos ) )
+      module = NULL;
 
-  FT_EXPORT_DEF( FT_Error )
-  FT_Open_Face( FT_Library           library,
-                const FT_Open_Args*  args,
-                FT_Long              face_index,
-                FT_Face             *aface )
-  {
-    return ft_open_face_internal( library, args, face_index, aface, 1 );
+    return module;
   }
 
 
@@ -2380,8 +3263,11 @@
     FT_Face      face   = NULL;
     FT_ListNode  node   = NULL;
     FT_Bool      external_stream;
-    FT_Module*   cur;
-    FT_Module*   limit;
+    FT_Module    sniffed = NULL;
+    FT_Error     sniffed_error = FT_Err_Ok;
+    FT_Stream    sniffed_stream;
+    FT_ULong     sniffed_pos;
+    FT_Int       n, num_probes = 0;
 
 #ifndef FT_CONFIG_OPTION_MAC_FONTS
     FT_UNUSED( test_mac_fonts );
@@ -2450,36 +3336,69 @@
     {
       error = FT_ERR( Missing_Module );
 
-      /* check each font driver for an appropriate format */
-      cur   = library->modules;
-      limit = cur + library->num_modules;
+      /* Start with the driver matching the file signature (if any).  */
+      /* If it fails, check each font driver for an appropriate format */
+      /* in the usual order, so that errors stay the same.             */
+      sniffed_stream = stream;
+      sniffed_pos    = FT_Stream_Pos( stream );
+      sniffed        = ft_open_face_sniff( library, stream );
 
-      for ( ; cur < limit; cur++ )
+      for ( n = sniffed ? -1 : 0; n < (FT_Int)library->num_modules; n++ )
       {
+        FT_Module  module = n < 0 ? sniffed : library->modules[n];
+
+
         /* not all modules are font drivers, so check... */
-        if ( FT_MODULE_IS_DRIVER( cur[0] ) )
+        if ( FT_MODULE_IS_DRIVER( module ) )
         {
           FT_Int         num_params = 0;
           FT_Parameter*  params     = NULL;
 
 
-          driver = FT_DRIVER( cur[0] );
-
           if ( args->flags & FT_OPEN_PARAMS )
           {
             num_params = args->num_params;
             params     = args->params;
           }
 
-          error = open_face( driver, &stream, external_stream, face_index,
-                             num_params, params, &face );
+          /* don't probe the sniffed driver twice but use its result */
+          if ( n >= 0 && module == sniffed )
+            error = sniffed_error;
+          else
+          {
+            driver = FT_DRIVER( module );
+            num_probes++;
+
+            error = open_face( driver, &stream, external_stream, face_index,
+                               num_params, params, &face );
+          }
           if ( !error )
+          {
+            FT_TRACE3(( "FT_Open_Face: `%s' driver accepted the font"
+                        " after %d probe%s\n",
+                        module->clazz->module_name,
+                        num_probes, num_probes == 1 ? "" : "s" ));
             goto Success;
+          }
+
+          if ( n < 0 )
+          {
+            sniffed_error = error;
+
+            /* the driver may have moved or replaced the stream */
+            error = FT_Stream_Seek( stream,
+                                    stream == sniffed_stream ? sniffed_pos
+                                                             : 0 );
+            if ( error )
+              break;
+
+            continue;
+          }
 
 #ifdef FT_CONFIG_OPTION_MAC_FONTS
-          if ( test_mac_fonts                                           &&
-               ft_strcmp( cur[0]->clazz->module_name, "truetype" ) == 0 &&
-               FT_ERR_EQ( error, Table_Missing )                        )
+          if ( test_mac_fonts                                         &&
+               ft_strcmp( module->clazz->module_name, "truetype" ) == 0 &&
+               FT_ERR_EQ( error, Table_Missing )                      )
           {
             /* TrueType but essential tables are missing */
             error = FT_Stream_Seek( stream, 0 );
@@ -2555,6 +3474,8 @@
     /* face->driver instead.                                   */
     FT_List_Add( &face->driver->faces_list, node );
 
+    face->internal->list_node = node;
+
     /* now allocate a glyph slot object for the face */
     FT_TRACE4(( "FT_Open_Face: Creating glyph slot\n" ));
 
@@ -2780,8 +3701,8 @@
         driver = face->driver;
         memory = driver->root.memory;
 
-        /* find face in driver's list */
-        node = FT_List_Find( &driver->faces_list, face );
+        /* the face's node in the driver's list, if any */
+        node = face->internal->list_node;
         if ( node )
         {
           /* remove face object from the driver's list */
@@ -2829,7 +3750,7 @@
 
     driver = face->driver;
     clazz  = driver->clazz;
-    memory = face->memory;
+    memory = driver->root.memory;   /* as in `FT_Done_Size' */
 
     /* Allocate new size object and perform basic initialisation */
     if ( FT_ALLOC( size, clazz->size_object_size ) || FT_NEW( node ) )
@@ -2843,14 +3764,25 @@
     size->internal = internal;
 
     if ( clazz->init_size )
+    {
+      FT_Size  owner = ft_mem_account_set_owner( face, size );
+
+
       error = clazz->init_size( size );
 
+      ft_mem_account_set_owner( face, owner );
+      if ( error && face->internal->memory_account )
+        ft_mem_account_forget_size( face->internal->memory_account, size );
+    }
+
     /* in case of success, add to the face's list */
     if ( !error )
     {
       *asize     = size;
       node->data = size;
       FT_List_Add( &face->sizes_list, node );
+
+      internal->list_node = node;
     }
 
   Exit:
@@ -2892,7 +3824,7 @@
     memory = driver->root.memory;
 
     error = FT_Err_Ok;
-    node  = FT_List_Find( &face->sizes_list, size );
+    node  = size->internal->list_node;
     if ( node )
     {
       FT_List_Remove( &face->sizes_list, node );
@@ -3197,8 +4129,13 @@
 
     if ( clazz->select_size )
     {
+      FT_Size  owner = ft_mem_account_set_owner( face, face->size );
+
+
       error = clazz->select_size( face->size, (FT_ULong)strike_index );
 
+      ft_mem_account_set_owner( face, owner );
+
       FT_TRACE5(( "FT_Select_Size (%s driver):\n",
                   face->driver->root.clazz->module_name ));
     }
@@ -3257,8 +4194,13 @@
 
     if ( clazz->request_size )
     {
+      FT_Size  owner = ft_mem_account_set_owner( face, face->size );
+
+
       error = clazz->request_size( face->size, req );
 
+      ft_mem_account_set_owner( face, owner );
+
       FT_TRACE5(( "FT_Request_Size (%s driver):\n",
                   face->driver->root.clazz->module_name ));
     }
@@ -3872,6 +4814,79 @@
   }
 
 
+  /* documentation is in freetype.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Face_GetMemoryUsage( FT_Face    face,
+                          FT_ULong  *acurrent,
+                          FT_ULong  *apeak )
+  {
+    FT_MemAccount  account;
+
+
+    if ( !face )
+      return FT_THROW( Invalid_Face_Handle );
+
+    account = face->internal->memory_account;
+    if ( !account )
+      return FT_THROW( Invalid_Argument );
+
+    if ( acurrent )
+      *acurrent = account->used;
+    if ( apeak )
+      *apeak = account->max_used;
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in freetype.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Size_GetMemoryUsage( FT_Size    size,
+                          FT_ULong  *acurrent )
+  {
+    if ( !size )
+      return FT_THROW( Invalid_Size_Handle );
+
+    if ( !size->face )
+      return FT_THROW( Invalid_Face_Handle );
+
+    if ( !acurrent || !size->face->internal->memory_account )
+      return FT_THROW( Invalid_Argument );
+
+    *acurrent = size->internal->memory_used;
+
+    return FT_Err_Ok;
+  }
+
+
+  /* documentation is in freetype.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Face_SetMemoryBudget( FT_Face   face,
+                           FT_ULong  budget )
+  {
+    FT_MemAccount  account;
+
+
+    if ( !face )
+      return FT_THROW( Invalid_Face_Handle );
+
+    account = face->internal->memory_account;
+    if ( !account )
+      return FT_THROW( Invalid_Argument );
+
+    account->budget      = budget;
+    account->over_budget = FT_BOOL( budget && account->used > budget );
+
+    if ( account->over_budget && !account->load_depth )
+      ft_face_purge( face );
+
+    return FT_Err_Ok;
+  }
+
+
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_UInt )
@@ -4525,10 +5540,12 @@
   }
 
 
-  FT_BASE_DEF( FT_Error )
-  FT_Render_Glyph_Internal( FT_Library      library,
-                            FT_GlyphSlot    slot,
-                            FT_Render_Mode  render_mode )
+  /* render `slot', shifting the glyph image by `origin' if non-NULL */
+  static FT_Error
+  ft_render_glyph( FT_Library        library,
+                   FT_GlyphSlot      slot,
+                   FT_Render_Mode    render_mode,
+                   const FT_Vector*  origin )
   {
     FT_Error     error = FT_Err_Ok;
     FT_Face      face  = slot->face;
@@ -4577,10 +5594,33 @@
               /* right here in this function                         */
               load_flags &= ~FT_LOAD_COLOR;
 
-              /* render into the new `face->glyph' glyph slot */
-              load_flags |= FT_LOAD_RENDER;
-
-              error = FT_Load_Glyph( face, glyph_index, load_flags );
+              if ( !origin )
+              {
+                /* render into the new `face->glyph' glyph slot */
+                load_flags |= FT_LOAD_RENDER;
+
+                error = FT_Load_Glyph( face, glyph_index, load_flags );
+              }
+              else
+              {
+                /* the layers must be shifted like the base glyph, */
+                /* so we render them ourselves                     */
+                FT_Render_Mode  mode = FT_LOAD_TARGET_MODE( load_flags );
+
+
+                if ( mode == FT_RENDER_MODE_NORMAL   &&
+                     load_flags & FT_LOAD_MONOCHROME )
+                  mode = FT_RENDER_MODE_MONO;
+
+                load_flags &= ~FT_LOAD_RENDER;
+
+                error = FT_Load_Glyph( face, glyph_index, load_flags );
+                if ( !error                                             &&
+                     face->glyph->format != FT_GLYPH_FORMAT_BITMAP    &&
+                     face->glyph->format != FT_GLYPH_FORMAT_COMPOSITE )
+                  error = ft_render_glyph( library, face->glyph,
+                                           mode, origin );
+              }
               if ( error )
                 break;
 
@@ -4630,7 +5670,7 @@
         error = FT_ERR( Unimplemented_Feature );
         while ( renderer )
         {
-          error = renderer->render( renderer, slot, render_mode, NULL );
+          error = renderer->render( renderer, slot, render_mode, origin );
           if ( !error                                   ||
                FT_ERR_NEQ( error, Cannot_Render_Glyph ) )
             break;
@@ -4771,6 +5811,15 @@
   }
 
 
+  FT_BASE_DEF( FT_Error )
+  FT_Render_Glyph_Internal( FT_Library      library,
+                            FT_GlyphSlot    slot,
+                            FT_Render_Mode  render_mode )
+  {
+    return ft_render_glyph( library, slot, render_mode, NULL );
+  }
+
+
   /* documentation is in freetype.h */
 
   FT_EXPORT_DEF( FT_Error )
@@ -4789,6 +5838,264 @@
   }
 
 
+  /* documentation is in freetype.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Render_Glyph_Subpixel( FT_GlyphSlot    slot,
+                            FT_Render_Mode  render_mode,
+                            FT_Pos          x_offset,
+                            FT_UInt         num_bins )
+  {
+    FT_Library  library;
+    FT_Vector   origin;
+
+
+    if ( !slot || !slot->face || !num_bins )
+      return FT_THROW( Invalid_Argument );
+
+    library = FT_FACE_LIBRARY( slot->face );
+
+    origin.x = FT_SUBPIXEL_QUANTIZE( x_offset, num_bins );
+    origin.y = 0;
+
+    /* an empty outline would otherwise get a one-pixel blank bitmap */
+    if ( !origin.x                                           ||
+         ( slot->format == FT_GLYPH_FORMAT_OUTLINE         &&
+           !slot->outline.n_points                         &&
+           !( slot->internal->load_flags & FT_LOAD_COLOR ) ) )
+      return FT_Render_Glyph_Internal( library, slot, render_mode );
+
+    return ft_render_glyph( library, slot, render_mode, &origin );
+  }
+
+
+  /* add the spans of a later chunk of a glyph run to its target, */
+  /* saturating the coverage                                      */
+  static void
+  ft_glyph_run_spans( int             y,
+                      int             count,
+                      const FT_Span*  spans,
+                      void*           user )
+  {
+    FT_Bitmap*      target = (FT_Bitmap*)user;
+    unsigned char*  row    = target->buffer;
+
+
+    if ( target->pitch > 0 )
+      row += (FT_PtrDist)( target->rows - 1 ) * target->pitch;
+    row -= (FT_PtrDist)y * target->pitch;
+
+    for ( ; count > 0; count--, spans++ )
+    {
+      unsigned char*  p   = row + spans->x;
+      unsigned char*  end = p + spans->len;
+      unsigned int    c   = spans->coverage;
+
+
+      for ( ; p < end; p++ )
+      {
+        unsigned int  v = *p + c;
+
+
+        *p = (unsigned char)( v > 255 ? 255 : v );
+      }
+    }
+  }
+
+
+  /* render the outlines collected so far in one pass */
+  static FT_Error
+  ft_glyph_run_flush( FT_Library   library,
+                      FT_Outline*  run,
+                      FT_Bitmap*   target,
+                      FT_Bool      first )
+  {
+    FT_Raster_Params  params;
+
+
+    if ( !run->n_contours )
+      return FT_Err_Ok;
+
+    params.target = target;
+    params.flags  = FT_RASTER_FLAG_AA;
+
+    /* the first chunk is rendered directly into the target; */
+    /* any later ones get added to it                        */
+    if ( !first )
+    {
+      params.flags        |= FT_RASTER_FLAG_DIRECT | FT_RASTER_FLAG_CLIP;
+      params.gray_spans    = ft_glyph_run_spans;
+      params.user          = target;
+      params.clip_box.xMin = 0;
+      params.clip_box.yMin = 0;
+      params.clip_box.xMax = (FT_Pos)target->width;
+      params.clip_box.yMax = (FT_Pos)target->rows;
+    }
+
+    return FT_Outline_Render( library, run, &params );
+  }
+
+
+  /* documentation is in freetype.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Render_Glyph_Run( FT_Face           face,
+                       FT_UInt           num_glyphs,
+                       const FT_UInt*    glyph_indices,
+                       const FT_Vector*  positions,
+                       FT_Int32          load_flags,
+                       FT_Bitmap*        target )
+  {
+    FT_Error    error = FT_Err_Ok;
+    FT_Library  library;
+    FT_Memory   memory;
+
+    FT_Outline  run;
+    FT_UInt     max_points   = 0;
+    FT_UInt     max_contours = 0;
+    FT_Bool     first        = TRUE;
+    FT_Pos      x_max, y_max;
+    FT_UInt     n;
+
+
+    if ( !face )
+      return FT_THROW( Invalid_Face_Handle );
+
+    if ( !target                                       ||
+         !target->buffer                               ||
+         target->pixel_mode != FT_PIXEL_MODE_GRAY      ||
+         ( num_glyphs && ( !glyph_indices || !positions ) ) )
+      return FT_THROW( Invalid_Argument );
+
+    library = FT_FACE_LIBRARY( face );
+    memory  = FT_FACE_MEMORY( face );
+
+    FT_ZERO( &run );
+
+    /* we only need the outlines */
+    load_flags &= ~( FT_LOAD_RENDER | FT_LOAD_COLOR );
+    load_flags |= FT_LOAD_NO_BITMAP;
+
+    x_max = (FT_Pos)target->width * 64;
+    y_max = (FT_Pos)target->rows  * 64;
+
+    /* The rasterizer keeps the cells of each row sorted from left to  */
+    /* right, searching from the left.  For runs in visual order, the   */
+    /* insertion of cells is thus cheapest if we start with the last    */
+    /* glyph.                                                           */
+    for ( n = num_glyphs; n > 0; n-- )
+    {
+      FT_Outline*  outline = &face->glyph->outline;
+      FT_Pos       dx      = positions[n - 1].x;
+      FT_Pos       dy      = positions[n - 1].y;
+      FT_BBox      cbox;
+      FT_UInt      num_points, num_contours;
+      FT_UInt      i;
+
+
+      error = FT_Load_Glyph( face, glyph_indices[n - 1], load_flags );
+      if ( error )
+        goto Exit;
+
+      if ( face->glyph->format != FT_GLYPH_FORMAT_OUTLINE )
+      {
+        error = FT_THROW( Invalid_Glyph_Format );
+        goto Exit;
+      }
+
+      num_points   = (FT_UInt)outline->n_points;
+      num_contours = (FT_UInt)outline->n_contours;
+      if ( !num_contours )
+        continue;
+
+      /* skip glyphs that don't intersect the target */
+      FT_Outline_Get_CBox( outline, &cbox );
+      if ( ADD_LONG( cbox.xMax, dx ) <= 0     ||
+           ADD_LONG( cbox.xMin, dx ) >= x_max ||
+           ADD_LONG( cbox.yMax, dy ) <= 0     ||
+           ADD_LONG( cbox.yMin, dy ) >= y_max )
+        continue;
+
+      /* an outline can only hold so many points; render what we have */
+      if ( (FT_UInt)run.n_points + num_points > FT_OUTLINE_POINTS_MAX     ||
+           (FT_UInt)run.n_contours + num_contours > FT_OUTLINE_CONTOURS_MAX )
+      {
+        error = ft_glyph_run_flush( library, &run, target, first );
+        if ( error )
+          goto Exit;
+
+        first          = FALSE;
+        run.n_points   = 0;
+        run.n_contours = 0;
+        run.flags      = 0;
+      }
+
+      if ( (FT_UInt)run.n_points + num_points > max_points )
+      {
+        FT_UInt  new_max = (FT_UInt)run.n_points + num_points;
+
+
+        new_max += new_max / 2;
+        if ( new_max > FT_OUTLINE_POINTS_MAX )
+          new_max = FT_OUTLINE_POINTS_MAX;
+
+        if ( FT_RENEW_ARRAY( run.points, max_points, new_max ) ||
+             FT_RENEW_ARRAY( run.tags, max_points, new_max )   )
+          goto Exit;
+
+        max_points = new_max;
+      }
+
+      if ( (FT_UInt)run.n_contours + num_contours > max_contours )
+      {
+        FT_UInt  new_max = (FT_UInt)run.n_contours + num_contours;
+
+
+        new_max += new_max / 2;
+        if ( new_max > FT_OUTLINE_CONTOURS_MAX )
+          new_max = FT_OUTLINE_CONTOURS_MAX;
+
+        if ( FT_RENEW_ARRAY( run.contours, max_contours, new_max ) )
+          goto Exit;
+
+        max_contours = new_max;
+      }
+
+      /* append the glyph, moved to its position */
+      {
+        FT_Vector*  vec = run.points + run.n_points;
+
+
+        for ( i = 0; i < num_points; i++ )
+        {
+          vec[i].x = ADD_LONG( outline->points[i].x, dx );
+          vec[i].y = ADD_LONG( outline->points[i].y, dy );
+        }
+      }
+
+      FT_MEM_COPY( run.tags + run.n_points, outline->tags, num_points );
+
+      for ( i = 0; i < num_contours; i++ )
+        run.contours[run.n_contours + (FT_Int)i] =
+          (short)( outline->contours[i] + run.n_points );
+
+      run.n_points   = (short)( run.n_points + (FT_Int)num_points );
+      run.n_contours = (short)( run.n_contours + (FT_Int)num_contours );
+      run.flags     |= outline->flags & ( FT_OUTLINE_EVEN_ODD_FILL |
+                                          FT_OUTLINE_OVERLAP       );
+    }
+
+    error = ft_glyph_run_flush( library, &run, target, first );
+
+  Exit:
+    FT_FREE( run.points );
+    FT_FREE( run.tags );
+    FT_FREE( run.contours );
+
+    return error;
+  }
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*************************************************************************/
@@ -5290,6 +6597,8 @@
 
     library->refcount = 1;
 
+    library->rfork_guessing = FT_RFORK_GUESSING_ALL;
+
     /* That's ok now */
     *alibrary = library;
 
@@ -5424,6 +6733,10 @@
     }
 #endif
 
+#if !defined( FT_MACINTOSH ) && defined( FT_CONFIG_OPTION_MAC_FONTS )
+    ft_rfork_misses_reset( library, FALSE );
+#endif
+
     FT_FREE( library );
 
   Exit:
@@ -5431,6 +6744,34 @@
   }
 
 
+  /* documentation is in ftmodapi.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Library_SetRForkGuessing( FT_Library         library,
+                               FT_RFork_Guessing  mode,
+                               FT_Bool            cache_misses )
+  {
+    if ( !library )
+      return FT_THROW( Invalid_Library_Handle );
+
+    if ( (FT_UInt)mode > FT_RFORK_GUESSING_ALL )
+      return FT_THROW( Invalid_Argument );
+
+    library->rfork_guessing = (FT_UInt)mode;
+
+#if !defined( FT_MACINTOSH ) && defined( FT_CONFIG_OPTION_MAC_FONTS )
+    ft_rfork_misses_reset( library, cache_misses );
+
+    if ( cache_misses && !library->rfork_misses )
+      return FT_THROW( Out_Of_Memory );
+#else
+    FT_UNUSED( cache_misses );
+#endif
+
+    return FT_Err_Ok;
+  }
+
+
   /* documentation is in ftmodapi.h */
 
   FT_EXPORT_DEF( void )
@@ -287,6 +287,251 @@
   }
 
 
+  /* Append a single outline to `path'; this follows the logic of */
+  /* `FT_Outline_Decompose' but stores the segments directly.       */
+
+  static FT_Error
+  ft_outline_export( const FT_Outline*  outline,
+                     const FT_Matrix*   matrix,
+                     FT_Pos             dx,
+                     FT_Pos             dy,
+                     FT_Outline_Path*   path )
+  {
+#undef  NEED
+#define NEED( nv, np )                                   \
+          FT_BEGIN_STMNT                                 \
+            if ( verb + (nv) > verb_limit    ||          \
+                 vec  + (np) > vec_limit     )           \
+              return FT_THROW( Array_Too_Large );        \
+          FT_END_STMNT
+
+#undef  EMIT
+#define EMIT( v )                                        \
+          FT_BEGIN_STMNT                                 \
+            *vec = (v);                                  \
+            if ( matrix )                                \
+              FT_Vector_Transform( vec, matrix );        \
+            vec->x += dx;                                \
+            vec->y += dy;                                \
+            vec++;                                       \
+          FT_END_STMNT
+
+    FT_Byte*    verb       = path->verbs  + path->num_verbs;
+    FT_Byte*    verb_limit = path->verbs  + path->max_verbs;
+    FT_Vector*  vec        = path->points + path->num_points;
+    FT_Vector*  vec_limit  = path->points + path->max_points;
+
+    FT_Vector   v_start;
+    FT_Vector   v_control;
+
+    FT_Vector*  point;
+    FT_Vector*  limit;
+    char*       tags;
+
+    FT_Int   n;
+    FT_UInt  first = 0;
+    FT_Int   tag;
+
+
+    for ( n = 0; n < outline->n_contours; n++ )
+    {
+      FT_Int  last = outline->contours[n];
+
+
+      if ( last < 0 || (FT_UInt)last < first )
+        return FT_THROW( Invalid_Outline );
+
+      limit   = outline->points + last;
+      v_start = outline->points[first];
+
+      point = outline->points + first;
+      tags  = outline->tags   + first;
+      tag   = FT_CURVE_TAG( tags[0] );
+
+      if ( tag == FT_CURVE_TAG_CUBIC )
+        return FT_THROW( Invalid_Outline );
+
+      if ( tag == FT_CURVE_TAG_CONIC )
+      {
+        FT_Vector  v_last = outline->points[last];
+
+
+        if ( FT_CURVE_TAG( outline->tags[last] ) == FT_CURVE_TAG_ON )
+        {
+          v_start = v_last;
+          limit--;
+        }
+        else
+        {
+          v_start.x = ( v_start.x + v_last.x ) / 2;
+          v_start.y = ( v_start.y + v_last.y ) / 2;
+        }
+        point--;
+        tags--;
+      }
+
+      NEED( 1, 1 );
+      *verb++ = FT_PATH_VERB_MOVE_TO;
+      EMIT( v_start );
+
+      while ( point < limit )
+      {
+        point++;
+        tags++;
+
+        tag = FT_CURVE_TAG( tags[0] );
+        switch ( tag )
+        {
+        case FT_CURVE_TAG_ON:
+          NEED( 1, 1 );
+          *verb++ = FT_PATH_VERB_LINE_TO;
+          EMIT( *point );
+          continue;
+
+        case FT_CURVE_TAG_CONIC:
+          v_control = *point;
+
+        Do_Conic:
+          NEED( 1, 2 );
+          *verb++ = FT_PATH_VERB_CONIC_TO;
+          EMIT( v_control );
+
+          if ( point < limit )
+          {
+            FT_Vector  v_middle;
+
+
+            point++;
+            tags++;
+            tag = FT_CURVE_TAG( tags[0] );
+
+            if ( tag == FT_CURVE_TAG_ON )
+            {
+              EMIT( *point );
+              continue;
+            }
+
+            if ( tag != FT_CURVE_TAG_CONIC )
+              return FT_THROW( Invalid_Outline );
+
+            v_middle.x = ( v_control.x + point->x ) / 2;
+            v_middle.y = ( v_control.y + point->y ) / 2;
+            EMIT( v_middle );
+
+            v_control = *point;
+            goto Do_Conic;
+          }
+
+          EMIT( v_start );
+          goto Close;
+
+        default:  /* FT_CURVE_TAG_CUBIC */
+          if ( point + 1 > limit                             ||
+               FT_CURVE_TAG( tags[1] ) != FT_CURVE_TAG_CUBIC )
+            return FT_THROW( Invalid_Outline );
+
+          NEED( 1, 3 );
+          *verb++ = FT_PATH_VERB_CUBIC_TO;
+          EMIT( point[0] );
+          EMIT( point[1] );
+
+          point += 2;
+          tags  += 2;
+
+          if ( point <= limit )
+          {
+            EMIT( *point );
+            continue;
+          }
+
+          EMIT( v_start );
+          goto Close;
+        }
+      }
+
+      /* close the contour with a line segment */
+      NEED( 1, 1 );
+      *verb++ = FT_PATH_VERB_LINE_TO;
+      EMIT( v_start );
+
+    Close:
+      NEED( 1, 0 );
+      *verb++ = FT_PATH_VERB_CLOSE;
+
+      first = (FT_UInt)last + 1;
+    }
+
+    path->num_verbs  = (FT_UInt)( verb - path->verbs );
+    path->num_points = (FT_UInt)( vec - path->points );
+
+    return FT_Err_Ok;
+
+#undef NEED
+#undef EMIT
+  }
+
+
+  /* documentation is in ftoutln.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FT_Outline_Export( FT_UInt                   num_outlines,
+                     const FT_Outline* const*  outlines,
+                     const FT_Vector*          origins,
+                     const FT_Matrix*          matrix,
+                     FT_Outline_Path*          path )
+  {
+    FT_Error  error = FT_Err_Ok;
+    FT_UInt   num_verbs, num_points;
+    FT_UInt   i;
+
+
+    if ( !path || ( num_outlines && !outlines ) )
+      return FT_THROW( Invalid_Argument );
+
+    if ( path->num_verbs  > path->max_verbs             ||
+         path->num_points > path->max_points            ||
+         ( path->max_verbs  && !path->verbs  )          ||
+         ( path->max_points && !path->points )          )
+      return FT_THROW( Invalid_Argument );
+
+    num_verbs  = path->num_verbs;
+    num_points = path->num_points;
+
+    for ( i = 0; i < num_outlines; i++ )
+    {
+      const FT_Outline*  outline = outlines[i];
+      FT_Pos             dx      = 0;
+      FT_Pos             dy      = 0;
+
+
+      if ( !outline )
+      {
+        error = FT_THROW( Invalid_Outline );
+        break;
+      }
+
+      if ( origins )
+      {
+        dx = origins[i].x;
+        dy = origins[i].y;
+      }
+
+      error = ft_outline_export( outline, matrix, dx, dy, path );
+      if ( error )
+        break;
+    }
+
+    if ( error )
+    {
+      /* leave the path as it was */
+      path->num_verbs  = num_verbs;
+      path->num_points = num_points;
+    }
+
+    return error;
+  }
+
+
   /* documentation is in ftoutln.h */
 
   FT_EXPORT_DEF( FT_Error )
@@ -445,6 +445,40 @@
                           const char  *original_name,
                           const char  *insertion );
 
+  /* Check whether a rule can find a resource fork on the host system. */
+  /* The Darwin VFS paths need a Mac kernel, while the other file name */
+  /* conventions come from file servers and mounts on other systems.   */
+  static FT_Bool
+  raccess_rule_is_native( FT_RFork_Rule  type )
+  {
+    switch ( type )
+    {
+#ifdef __APPLE__
+    case FT_RFork_Rule_vfat:
+    case FT_RFork_Rule_linux_cap:
+    case FT_RFork_Rule_linux_double:
+    case FT_RFork_Rule_linux_netatalk:
+#else
+    case FT_RFork_Rule_darwin_newvfs:
+    case FT_RFork_Rule_darwin_hfsplus:
+#endif
+      return FALSE;
+
+    default:
+      return TRUE;
+    }
+  }
+
+
+  /* Check whether a rule only reads the given file itself. */
+  static FT_Bool
+  raccess_rule_is_internal( FT_RFork_Rule  type )
+  {
+    return FT_BOOL( type == FT_RFork_Rule_apple_double ||
+                    type == FT_RFork_Rule_apple_single );
+  }
+
+
   FT_BASE_DEF( void )
   FT_Raccess_Guess( FT_Library  library,
                     FT_Stream   stream,
@@ -458,7 +492,20 @@
 
     for ( i = 0; i < FT_RACCESS_N_RULES; i++ )
     {
+      FT_RFork_Rule  type = ft_raccess_guess_table[i].type;
+
+
       new_names[i] = NULL;
+
+      if ( ( library->rfork_guessing == FT_RFORK_GUESSING_NONE   &&
+             !raccess_rule_is_internal( type )                 ) ||
+           ( library->rfork_guessing == FT_RFORK_GUESSING_NATIVE &&
+             !raccess_rule_is_native( type )                   ) )
+      {
+        errors[i] = FT_ERR( Unimplemented_Feature );
+        continue;
+      }
+
       if ( NULL != stream )
         errors[i] = FT_Stream_Seek( stream, 0 );
       else
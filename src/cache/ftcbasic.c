@@ -37,15 +37,108 @@
   {
     FTC_ScalerRec  scaler;
     FT_UInt        load_flags;
+    FT_UInt        x_shift;     /* quantized sub-pixel offset, 26.6 */
+    FT_Matrix      matrix;      /* quantized transformation         */
+    FT_Vector      delta;       /* fractional translation, 26.6     */
 
   } FTC_BasicAttrRec, *FTC_BasicAttrs;
 
 #define FTC_BASIC_ATTR_COMPARE( a, b )                                 \
           FT_BOOL( FTC_SCALER_COMPARE( &(a)->scaler, &(b)->scaler ) && \
-                   (a)->load_flags == (b)->load_flags               )
+                   (a)->load_flags == (b)->load_flags               && \
+                   (a)->x_shift    == (b)->x_shift                  && \
+                   (a)->matrix.xx  == (b)->matrix.xx                && \
+                   (a)->matrix.xy  == (b)->matrix.xy                && \
+                   (a)->matrix.yx  == (b)->matrix.yx                && \
+                   (a)->matrix.yy  == (b)->matrix.yy                && \
+                   (a)->delta.x    == (b)->delta.x                  && \
+                   (a)->delta.y    == (b)->delta.y                  )
+
+#define FTC_BASIC_ATTR_HASH( a )                                    \
+          ( FTC_SCALER_HASH( &(a)->scaler ) + 31 * (a)->load_flags + \
+            61 * (a)->x_shift                                      + \
+            ( (FT_Offset)(a)->matrix.xx                            ^ \
+              ( (FT_Offset)(a)->matrix.xy << 5 )                   ^ \
+              ( (FT_Offset)(a)->matrix.yx << 10 )                  ^ \
+              ( (FT_Offset)(a)->matrix.yy << 15 ) )                + \
+            67 * (FT_Offset)( (a)->delta.x + 64 * (a)->delta.y )    )
+
+#define FTC_BASIC_ATTR_HAS_TRANSFORM( a )   \
+          ( (a)->matrix.xx != 0x10000L ||   \
+            (a)->matrix.xy != 0        ||   \
+            (a)->matrix.yx != 0        ||   \
+            (a)->matrix.yy != 0x10000L ||   \
+            (a)->delta.x   != 0        ||   \
+            (a)->delta.y   != 0        )
+
+  /* matrix coefficients are rounded to multiples of 1/4096 */
+#define FTC_MATRIX_QUANTIZE( x )  ( ( (x) + 8 ) & ~15L )
+
+
+  /* Set the transformation part of a cache key.  The matrix gets     */
+  /* quantized so that nearly identical transformations share cache   */
+  /* entries; only the fractional part of the translation is kept     */
+  /* since the caller positions the glyph at whole pixels anyway.     */
+  static void
+  ftc_basic_attrs_set_transform( FTC_BasicAttrs    attrs,
+                                 const FT_Matrix*  matrix,
+                                 const FT_Vector*  delta )
+  {
+    if ( matrix )
+    {
+      attrs->matrix.xx = FTC_MATRIX_QUANTIZE( matrix->xx );
+      attrs->matrix.xy = FTC_MATRIX_QUANTIZE( matrix->xy );
+      attrs->matrix.yx = FTC_MATRIX_QUANTIZE( matrix->yx );
+      attrs->matrix.yy = FTC_MATRIX_QUANTIZE( matrix->yy );
+    }
+    else
+    {
+      attrs->matrix.xx = 0x10000L;
+      attrs->matrix.xy = 0;
+      attrs->matrix.yx = 0;
+      attrs->matrix.yy = 0x10000L;
+    }
 
-#define FTC_BASIC_ATTR_HASH( a )                                     \
-          ( FTC_SCALER_HASH( &(a)->scaler ) + 31 * (a)->load_flags )
+    if ( delta )
+    {
+      attrs->delta.x = delta->x & 63;
+      attrs->delta.y = delta->y & 63;
+    }
+    else
+    {
+      attrs->delta.x = 0;
+      attrs->delta.y = 0;
+    }
+  }
+
+
+  /* Load a glyph with the transformation of `attrs', if any.  The */
+  /* face is shared with other caches, so its own transformation   */
+  /* gets restored afterwards.                                     */
+  static FT_Error
+  ftc_basic_attrs_load_glyph( FTC_BasicAttrs  attrs,
+                              FT_Face         face,
+                              FT_UInt         gindex,
+                              FT_Int32        load_flags )
+  {
+    FT_Face_Internal  internal = face->internal;
+    FT_Matrix         matrix;
+    FT_Vector         delta;
+    FT_Error          error;
+
+
+    if ( !FTC_BASIC_ATTR_HAS_TRANSFORM( attrs ) )
+      return FT_Load_Glyph( face, gindex, load_flags );
+
+    matrix = internal->transform_matrix;
+    delta  = internal->transform_delta;
+
+    FT_Set_Transform( face, &attrs->matrix, &attrs->delta );
+    error = FT_Load_Glyph( face, gindex, load_flags );
+    FT_Set_Transform( face, &matrix, &delta );
+
+    return error;
+  }
 
 
   typedef struct  FTC_BasicQueryRec_
@@ -76,6 +169,26 @@
   }
 
 
+  FT_CALLBACK_DEF( FT_Offset )
+  ftc_basic_family_hash( FTC_MruNode  ftcfamily )
+  {
+    FTC_BasicFamily  family = (FTC_BasicFamily)ftcfamily;
+
+
+    return FTC_BASIC_ATTR_HASH( &family->attrs );
+  }
+
+
+  FT_CALLBACK_DEF( FT_Offset )
+  ftc_basic_query_hash( FT_Pointer  ftcquery )
+  {
+    FTC_BasicQuery  query = (FTC_BasicQuery)ftcquery;
+
+
+    return FTC_BASIC_ATTR_HASH( &query->attrs );
+  }
+
+
   FT_CALLBACK_DEF( FT_Error )
   ftc_basic_family_init( FTC_MruNode  ftcfamily,
                          FT_Pointer   ftcquery,
@@ -136,13 +249,38 @@
     error = FTC_Manager_LookupSize( manager, &family->attrs.scaler, &size );
     if ( !error )
     {
-      FT_Face  face = size->face;
+      FT_Face   face       = size->face;
+      FT_Int32  load_flags = (FT_Int32)family->attrs.load_flags;
+
+
+      if ( !family->attrs.x_shift )
+        error = ftc_basic_attrs_load_glyph( &family->attrs, face, gindex,
+                                            load_flags | FT_LOAD_RENDER );
+      else
+      {
+        /* load the outline, then render it at the sub-pixel offset */
+        /* with the same render mode `FT_Load_Glyph' would select   */
+        FT_GlyphSlot  slot = face->glyph;
+
 
+        error = ftc_basic_attrs_load_glyph( &family->attrs, face, gindex,
+                                            load_flags );
+        if ( !error                                    &&
+             ( load_flags & FT_LOAD_NO_SCALE ) == 0    &&
+             slot->format != FT_GLYPH_FORMAT_BITMAP    &&
+             slot->format != FT_GLYPH_FORMAT_COMPOSITE )
+        {
+          FT_Render_Mode  mode = FT_LOAD_TARGET_MODE( load_flags );
 
-      error = FT_Load_Glyph(
-                face,
-                gindex,
-                (FT_Int)family->attrs.load_flags | FT_LOAD_RENDER );
+
+          if ( mode == FT_RENDER_MODE_NORMAL   &&
+               load_flags & FT_LOAD_MONOCHROME )
+            mode = FT_RENDER_MODE_MONO;
+
+          error = FT_Render_Glyph_Subpixel( slot, mode,
+                                            family->attrs.x_shift, 64 );
+        }
+      }
       if ( !error )
         *aface = face;
     }
@@ -172,9 +310,10 @@
     {
       face = size->face;
 
-      error = FT_Load_Glyph( face,
-                             gindex,
-                             (FT_Int)family->attrs.load_flags );
+      error = ftc_basic_attrs_load_glyph( &family->attrs,
+                                          face,
+                                          gindex,
+                                          (FT_Int)family->attrs.load_flags );
       if ( !error )
       {
         if ( face->glyph->format == FT_GLYPH_FORMAT_BITMAP  ||
@@ -201,6 +340,43 @@
   }
 
 
+  FT_CALLBACK_DEF( FT_Error )
+  ftc_basic_family_load_outline( FTC_Family  ftcfamily,
+                                 FT_UInt     gindex,
+                                 FTC_Cache   cache,
+                                 FT_Glyph   *aglyph )
+  {
+    FTC_BasicFamily  family = (FTC_BasicFamily)ftcfamily;
+    FT_Error         error;
+    FT_Face          face;
+
+
+    /* unscaled outlines don't need a size object */
+    error = FTC_Manager_LookupFace( cache->manager,
+                                    family->attrs.scaler.face_id,
+                                    &face );
+    if ( error )
+      goto Exit;
+
+    error = FT_Load_Glyph( face,
+                           gindex,
+                           (FT_Int)family->attrs.load_flags );
+    if ( error )
+      goto Exit;
+
+    if ( face->glyph->format != FT_GLYPH_FORMAT_OUTLINE )
+    {
+      error = FT_THROW( Invalid_Argument );
+      goto Exit;
+    }
+
+    error = FT_Get_Glyph( face->glyph, aglyph );
+
+  Exit:
+    return error;
+  }
+
+
   FT_CALLBACK_DEF( FT_Bool )
   ftc_basic_gnode_compare_faceid( FTC_Node    ftcgnode,
                                   FT_Pointer  ftcface_id,
@@ -242,7 +418,9 @@
       ftc_basic_family_compare, /* FTC_MruNode_CompareFunc  node_compare */
       ftc_basic_family_init,    /* FTC_MruNode_InitFunc     node_init    */
       NULL,                     /* FTC_MruNode_ResetFunc    node_reset   */
-      NULL                      /* FTC_MruNode_DoneFunc     node_done    */
+      NULL,                     /* FTC_MruNode_DoneFunc     node_done    */
+      ftc_basic_family_hash,    /* FTC_MruNode_HashFunc     node_hash    */
+      ftc_basic_query_hash      /* FTC_MruKey_HashFunc      key_hash     */
     },
 
     ftc_basic_family_load_glyph /* FTC_IFamily_LoadGlyphFunc  family_load_glyph */
@@ -322,6 +500,8 @@
     query.attrs.scaler.width   = type->width;
     query.attrs.scaler.height  = type->height;
     query.attrs.load_flags     = (FT_UInt)type->flags;
+    query.attrs.x_shift        = 0;
+    ftc_basic_attrs_set_transform( &query.attrs, NULL, NULL );
 
     query.attrs.scaler.pixel = 1;
     query.attrs.scaler.x_res = 0;  /* make compilers happy */
@@ -368,6 +548,24 @@
                                FT_UInt         gindex,
                                FT_Glyph       *aglyph,
                                FTC_Node       *anode )
+  {
+    return FTC_ImageCache_LookupTransform( cache, scaler, load_flags,
+                                           NULL, NULL, gindex,
+                                           aglyph, anode );
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_ImageCache_LookupTransform( FTC_ImageCache    cache,
+                                  FTC_Scaler        scaler,
+                                  FT_ULong          load_flags,
+                                  const FT_Matrix*  matrix,
+                                  const FT_Vector*  delta,
+                                  FT_UInt           gindex,
+                                  FT_Glyph         *aglyph,
+                                  FTC_Node         *anode )
   {
     FTC_BasicQueryRec  query;
     FTC_Node           node = 0; /* make compiler happy */
@@ -394,13 +592,15 @@
      */
 #if FT_ULONG_MAX > FT_UINT_MAX
     if ( load_flags > FT_UINT_MAX )
-      FT_TRACE1(( "FTC_ImageCache_LookupScaler:"
+      FT_TRACE1(( "FTC_ImageCache_LookupTransform:"
                   " higher bits in load_flags 0x%lx are dropped\n",
                   load_flags & ~((FT_ULong)FT_UINT_MAX) ));
 #endif
 
     query.attrs.scaler     = scaler[0];
     query.attrs.load_flags = (FT_UInt)load_flags;
+    query.attrs.x_shift    = 0;
+    ftc_basic_attrs_set_transform( &query.attrs, matrix, delta );
 
     hash = FTC_BASIC_ATTR_HASH( &query.attrs ) + gindex;
 
@@ -427,6 +627,148 @@
   }
 
 
+ /*
+  *
+  * unscaled outline cache
+  *
+  */
+
+  static
+  const FTC_IFamilyClassRec  ftc_basic_outline_family_class =
+  {
+    {
+      sizeof ( FTC_BasicFamilyRec ),
+
+      ftc_basic_family_compare, /* FTC_MruNode_CompareFunc  node_compare */
+      ftc_basic_family_init,    /* FTC_MruNode_InitFunc     node_init    */
+      NULL,                     /* FTC_MruNode_ResetFunc    node_reset   */
+      NULL,                     /* FTC_MruNode_DoneFunc     node_done    */
+      ftc_basic_family_hash,    /* FTC_MruNode_HashFunc     node_hash    */
+      ftc_basic_query_hash      /* FTC_MruKey_HashFunc      key_hash     */
+    },
+
+    ftc_basic_family_load_outline /* FTC_IFamily_LoadGlyphFunc  family_load_glyph */
+  };
+
+
+  static
+  const FTC_GCacheClassRec  ftc_basic_outline_cache_class =
+  {
+    {
+      ftc_inode_new,                  /* FTC_Node_NewFunc      node_new           */
+      ftc_inode_weight,               /* FTC_Node_WeightFunc   node_weight        */
+      ftc_gnode_compare,              /* FTC_Node_CompareFunc  node_compare       */
+      ftc_basic_gnode_compare_faceid, /* FTC_Node_CompareFunc  node_remove_faceid */
+      ftc_inode_free,                 /* FTC_Node_FreeFunc     node_free          */
+
+      sizeof ( FTC_GCacheRec ),
+      ftc_gcache_init,                /* FTC_Cache_InitFunc    cache_init         */
+      ftc_gcache_done                 /* FTC_Cache_DoneFunc    cache_done         */
+    },
+
+    (FTC_MruListClass)&ftc_basic_outline_family_class
+  };
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_OutlineCache_New( FTC_Manager        manager,
+                        FTC_OutlineCache  *acache )
+  {
+    return FTC_GCache_New( manager, &ftc_basic_outline_cache_class,
+                           (FTC_GCache*)acache );
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_OutlineCache_Lookup( FTC_OutlineCache  cache,
+                           FTC_Scaler        scaler,
+                           FT_ULong          load_flags,
+                           FT_UInt           gindex,
+                           FT_Glyph         *aglyph )
+  {
+    FTC_BasicQueryRec  query;
+    FTC_Node           node = 0; /* make compiler happy */
+    FT_Error           error;
+    FT_Offset          hash;
+    FT_Size            size;
+    FT_Fixed           x_scale, y_scale;
+    FT_OutlineGlyph    glyph;
+    FT_Vector*         vec;
+    FT_Vector*         limit;
+
+
+    /* some argument checks are delayed to `FTC_Cache_Lookup' */
+    if ( !aglyph || !scaler || !cache )
+    {
+      error = FT_THROW( Invalid_Argument );
+      goto Exit;
+    }
+
+    *aglyph = NULL;
+
+#if FT_ULONG_MAX > FT_UINT_MAX
+    if ( load_flags > FT_UINT_MAX )
+      FT_TRACE1(( "FTC_OutlineCache_Lookup:"
+                  " higher bits in load_flags 0x%lx are dropped\n",
+                  load_flags & ~((FT_ULong)FT_UINT_MAX) ));
+#endif
+
+    /* get the scale first; looking up the size never flushes nodes */
+    error = FTC_Manager_LookupSize( FTC_CACHE( cache )->manager,
+                                    scaler,
+                                    &size );
+    if ( error )
+      goto Exit;
+
+    x_scale = size->metrics.x_scale;
+    y_scale = size->metrics.y_scale;
+
+    /* the family key is the face ID alone */
+    FT_ZERO( &query.attrs );
+    ftc_basic_attrs_set_transform( &query.attrs, NULL, NULL );
+    query.attrs.scaler.face_id = scaler->face_id;
+    query.attrs.load_flags     = (FT_UInt)( load_flags | FT_LOAD_NO_SCALE );
+
+    hash = FTC_BASIC_ATTR_HASH( &query.attrs ) + gindex;
+
+    FTC_GCACHE_LOOKUP_CMP( cache,
+                           ftc_basic_family_compare,
+                           FTC_GNode_Compare,
+                           hash, gindex,
+                           &query,
+                           node,
+                           error );
+    if ( error )
+      goto Exit;
+
+    error = FT_Glyph_Copy( FTC_INODE( node )->glyph, (FT_Glyph*)&glyph );
+    if ( error )
+      goto Exit;
+
+    vec   = glyph->outline.points;
+    limit = vec + glyph->outline.n_points;
+
+    for ( ; vec < limit; vec++ )
+    {
+      vec->x = FT_MulFix( vec->x, x_scale );
+      vec->y = FT_MulFix( vec->y, y_scale );
+    }
+
+    /* the advance of an unscaled glyph is in font units (times 1024) */
+    glyph->root.advance.x = FT_MulFix( glyph->root.advance.x, x_scale );
+    glyph->root.advance.y = FT_MulFix( glyph->root.advance.y, y_scale );
+
+    *aglyph = (FT_Glyph)glyph;
+
+  Exit:
+    return error;
+  }
+
+
   /*
    *
    * basic small bitmap cache
@@ -441,7 +783,9 @@
       ftc_basic_family_compare,     /* FTC_MruNode_CompareFunc  node_compare */
       ftc_basic_family_init,        /* FTC_MruNode_InitFunc     node_init    */
       NULL,                         /* FTC_MruNode_ResetFunc    node_reset   */
-      NULL                          /* FTC_MruNode_DoneFunc     node_done    */
+      NULL,                         /* FTC_MruNode_DoneFunc     node_done    */
+      ftc_basic_family_hash,        /* FTC_MruNode_HashFunc     node_hash    */
+      ftc_basic_query_hash          /* FTC_MruKey_HashFunc      key_hash     */
     },
 
     ftc_basic_family_get_count,
@@ -520,6 +864,8 @@
     query.attrs.scaler.width   = type->width;
     query.attrs.scaler.height  = type->height;
     query.attrs.load_flags     = (FT_UInt)type->flags;
+    query.attrs.x_shift        = 0;
+    ftc_basic_attrs_set_transform( &query.attrs, NULL, NULL );
 
     query.attrs.scaler.pixel = 1;
     query.attrs.scaler.x_res = 0;  /* make compilers happy */
@@ -570,6 +916,23 @@
                               FT_UInt        gindex,
                               FTC_SBit      *ansbit,
                               FTC_Node      *anode )
+  {
+    return FTC_SBitCache_LookupSubpixel( cache, scaler, load_flags, gindex,
+                                         0, 1, ansbit, anode );
+  }
+
+
+  /* the common part of the sbit lookups with a scaler */
+  static FT_Error
+  ftc_basic_sbit_lookup( FTC_SBitCache     cache,
+                         FTC_Scaler        scaler,
+                         FT_ULong          load_flags,
+                         FT_UInt           x_shift,
+                         const FT_Matrix*  matrix,
+                         const FT_Vector*  delta,
+                         FT_UInt           gindex,
+                         FTC_SBit         *ansbit,
+                         FTC_Node         *anode )
   {
     FT_Error           error;
     FTC_BasicQueryRec  query;
@@ -594,13 +957,15 @@
      */
 #if FT_ULONG_MAX > FT_UINT_MAX
     if ( load_flags > FT_UINT_MAX )
-      FT_TRACE1(( "FTC_ImageCache_LookupScaler:"
+      FT_TRACE1(( "ftc_basic_sbit_lookup:"
                   " higher bits in load_flags 0x%lx are dropped\n",
                   load_flags & ~((FT_ULong)FT_UINT_MAX) ));
 #endif
 
     query.attrs.scaler     = scaler[0];
     query.attrs.load_flags = (FT_UInt)load_flags;
+    query.attrs.x_shift    = x_shift;
+    ftc_basic_attrs_set_transform( &query.attrs, matrix, delta );
 
     /* beware, the hash must be the same for all glyph ranges! */
     hash = FTC_BASIC_ATTR_HASH( &query.attrs ) +
@@ -630,4 +995,50 @@
   }
 
 
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_SBitCache_LookupSubpixel( FTC_SBitCache  cache,
+                                FTC_Scaler     scaler,
+                                FT_ULong       load_flags,
+                                FT_UInt        gindex,
+                                FT_Pos         x_offset,
+                                FT_UInt        num_bins,
+                                FTC_SBit      *ansbit,
+                                FTC_Node      *anode )
+  {
+    if ( !num_bins )
+    {
+      if ( anode )
+        *anode = NULL;
+
+      return FT_THROW( Invalid_Argument );
+    }
+
+    return ftc_basic_sbit_lookup(
+             cache, scaler, load_flags,
+             (FT_UInt)FT_SUBPIXEL_QUANTIZE( x_offset, num_bins ),
+             NULL, NULL,
+             gindex, ansbit, anode );
+  }
+
+
+  /* documentation is in ftcache.h */
+
+  FT_EXPORT_DEF( FT_Error )
+  FTC_SBitCache_LookupTransform( FTC_SBitCache     cache,
+                                 FTC_Scaler        scaler,
+                                 FT_ULong          load_flags,
+                                 const FT_Matrix*  matrix,
+                                 const FT_Vector*  delta,
+                                 FT_UInt           gindex,
+                                 FTC_SBit         *ansbit,
+                                 FTC_Node         *anode )
+  {
+    return ftc_basic_sbit_lookup( cache, scaler, load_flags, 0,
+                                  matrix, delta,
+                                  gindex, ansbit, anode );
+  }
+
+
 /* END */
@@ -36,16 +36,26 @@
    * codes to equivalent glyph indices.
    *
    * For now, the implementation is very basic: Each node maps a range of
-   * 128 consecutive character codes to their corresponding glyph indices.
+   * `FTC_CMAP_INDICES_MAX' consecutive character codes to their
+   * corresponding glyph indices.  Smaller ranges don't save memory, even
+   * for CJK ideographs or emoji, since the node header is then larger than
+   * the unused entries.
    *
-   * We could do more complex things, but I don't think it is really very
-   * useful.
+   * The nodes last returned by a lookup are additionally kept in a small
+   * direct-mapped table that is checked before the cache's hash table.
    *
    */
 
 
   /* number of glyph indices / character code per node */
+#ifndef FTC_CMAP_INDICES_MAX
 #define FTC_CMAP_INDICES_MAX  128
+#endif
+
+  /* number of slots in the direct-mapped node table; a power of 2 */
+#ifndef FTC_CMAP_HOT_SIZE
+#define FTC_CMAP_HOT_SIZE  256
+#endif
 
   /* compute a query/node hash */
 #define FTC_CMAP_HASH( faceid, index, charcode )         \
@@ -80,6 +90,20 @@
   /* glyph indices haven't been queried through FT_Get_Glyph_Index() yet   */
 #define FTC_CMAP_UNKNOWN  (FT_UInt16)~0
 
+  /* the cmap cache; `hot[hash % FTC_CMAP_HOT_SIZE]' is NULL or the node */
+  /* with that hash value returned by the last lookup using the slot     */
+  typedef struct  FTC_CMapCacheRec_
+  {
+    FTC_CacheRec  cache;
+    FTC_CMapNode  hot[FTC_CMAP_HOT_SIZE];
+
+  } FTC_CMapCacheRec;
+
+  /* small face IDs only differ in the higher bits of the hash */
+#define FTC_CMAP_HOT_SLOT( cache, hash )                               \
+          ( (FTC_CMapCache)(cache) )->hot[( (hash) ^ ( (hash) >> 8 ) ) & \
+                                          ( FTC_CMAP_HOT_SIZE - 1 )]
+
 
   /*************************************************************************/
   /*************************************************************************/
@@ -94,9 +118,13 @@
   ftc_cmap_node_free( FTC_Node   ftcnode,
                       FTC_Cache  cache )
   {
-    FTC_CMapNode  node   = (FTC_CMapNode)ftcnode;
-    FT_Memory     memory = cache->memory;
+    FTC_CMapNode   node   = (FTC_CMapNode)ftcnode;
+    FTC_CMapNode  *slot   = &FTC_CMAP_HOT_SLOT( cache, node->node.hash );
+    FT_Memory      memory = cache->memory;
+
 
+    if ( *slot == node )
+      *slot = NULL;
 
     FT_FREE( node );
   }
@@ -206,7 +234,7 @@
     ftc_cmap_node_remove_faceid, /* FTC_Node_CompareFunc  node_remove_faceid */
     ftc_cmap_node_free,          /* FTC_Node_FreeFunc     node_free          */
 
-    sizeof ( FTC_CacheRec ),
+    sizeof ( FTC_CMapCacheRec ),
     ftc_cache_init,              /* FTC_Cache_InitFunc    cache_init         */
     ftc_cache_done,              /* FTC_Cache_DoneFunc    cache_done         */
   };
@@ -234,7 +262,7 @@
   {
     FTC_Cache         cache = FTC_CACHE( cmap_cache );
     FTC_CMapQueryRec  query;
-    FTC_Node          node;
+    FTC_CMapNode      node;
     FT_Error          error;
     FT_UInt           gindex = 0;
     FT_Offset         hash;
@@ -258,31 +286,53 @@
       return 0;
     }
 
-    query.face_id    = face_id;
-    query.cmap_index = (FT_UInt)cmap_index;
-    query.char_code  = char_code;
-
     hash = FTC_CMAP_HASH( face_id, (FT_UInt)cmap_index, char_code );
 
+    /* try the direct-mapped table first */
+    node = FTC_CMAP_HOT_SLOT( cache, hash );
+    if ( node                                                        &&
+         node->face_id    == face_id                                 &&
+         node->cmap_index == (FT_UInt)cmap_index                     &&
+         (FT_UInt32)( char_code - node->first ) < FTC_CMAP_INDICES_MAX )
+    {
+      FTC_Manager  manager = cache->manager;
+
+
+      if ( &node->node != manager->nodes_list )
+        FTC_MruNode_Up( (FTC_MruNode*)&manager->nodes_list,
+                        (FTC_MruNode)node );
+    }
+    else
+    {
+      FTC_Node  cnode;
+
+
+      query.face_id    = face_id;
+      query.cmap_index = (FT_UInt)cmap_index;
+      query.char_code  = char_code;
+
 #if 1
-    FTC_CACHE_LOOKUP_CMP( cache, ftc_cmap_node_compare, hash, &query,
-                          node, error );
+      FTC_CACHE_LOOKUP_CMP( cache, ftc_cmap_node_compare, hash, &query,
+                            cnode, error );
 #else
-    error = FTC_Cache_Lookup( cache, hash, &query, &node );
+      error = FTC_Cache_Lookup( cache, hash, &query, &cnode );
 #endif
-    if ( error )
-      goto Exit;
+      if ( error )
+        goto Exit;
+
+      node = FTC_CMAP_NODE( cnode );
 
-    FT_ASSERT( (FT_UInt)( char_code - FTC_CMAP_NODE( node )->first ) <
-                FTC_CMAP_INDICES_MAX );
+      FT_ASSERT( (FT_UInt)( char_code - node->first ) <
+                  FTC_CMAP_INDICES_MAX );
 
-    /* something rotten can happen with rogue clients */
-    if ( (FT_UInt)( char_code - FTC_CMAP_NODE( node )->first >=
-                    FTC_CMAP_INDICES_MAX ) )
-      return 0; /* XXX: should return appropriate error */
+      /* something rotten can happen with rogue clients */
+      if ( (FT_UInt)( char_code - node->first >= FTC_CMAP_INDICES_MAX ) )
+        return 0; /* XXX: should return appropriate error */
+
+      FTC_CMAP_HOT_SLOT( cache, hash ) = node;
+    }
 
-    gindex = FTC_CMAP_NODE( node )->indices[char_code -
-                                            FTC_CMAP_NODE( node )->first];
+    gindex = node->indices[char_code - node->first];
     if ( gindex == FTC_CMAP_UNKNOWN )
     {
       FT_Face  face;
@@ -291,7 +341,7 @@
       gindex = 0;
 
       error = FTC_Manager_LookupFace( cache->manager,
-                                      FTC_CMAP_NODE( node )->face_id,
+                                      node->face_id,
                                       &face );
       if ( error )
         goto Exit;
@@ -313,9 +363,7 @@
           FT_Set_Charmap( face, old );
       }
 
-      FTC_CMAP_NODE( node )->indices[char_code -
-                                     FTC_CMAP_NODE( node )->first]
-        = (FT_UShort)gindex;
+      node->indices[char_code - node->first] = (FT_UShort)gindex;
     }
 
   Exit:
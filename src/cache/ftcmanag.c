@@ -147,6 +147,26 @@
   }
 
 
+  FT_CALLBACK_DEF( FT_Offset )
+  ftc_size_node_hash( FTC_MruNode  ftcnode )
+  {
+    FTC_SizeNode  node = (FTC_SizeNode)ftcnode;
+
+
+    return FTC_SCALER_HASH( &node->scaler );
+  }
+
+
+  FT_CALLBACK_DEF( FT_Offset )
+  ftc_size_key_hash( FT_Pointer  ftcscaler )
+  {
+    FTC_Scaler  scaler = (FTC_Scaler)ftcscaler;
+
+
+    return FTC_SCALER_HASH( scaler );
+  }
+
+
   static
   const FTC_MruListClassRec  ftc_size_list_class =
   {
@@ -155,7 +175,9 @@
     ftc_size_node_compare,  /* FTC_MruNode_CompareFunc  node_compare */
     ftc_size_node_init,     /* FTC_MruNode_InitFunc     node_init    */
     ftc_size_node_reset,    /* FTC_MruNode_ResetFunc    node_reset   */
-    ftc_size_node_done      /* FTC_MruNode_DoneFunc     node_done    */
+    ftc_size_node_done,     /* FTC_MruNode_DoneFunc     node_done    */
+    ftc_size_node_hash,     /* FTC_MruNode_HashFunc     node_hash    */
+    ftc_size_key_hash       /* FTC_MruKey_HashFunc      key_hash     */
   };
 
 
@@ -287,6 +309,23 @@
   }
 
 
+  FT_CALLBACK_DEF( FT_Offset )
+  ftc_face_node_hash( FTC_MruNode  ftcnode )
+  {
+    FTC_FaceNode  node = (FTC_FaceNode)ftcnode;
+
+
+    return FTC_FACE_ID_HASH( node->face_id );
+  }
+
+
+  FT_CALLBACK_DEF( FT_Offset )
+  ftc_face_key_hash( FT_Pointer  ftcface_id )
+  {
+    return FTC_FACE_ID_HASH( ftcface_id );
+  }
+
+
   static
   const FTC_MruListClassRec  ftc_face_list_class =
   {
@@ -295,7 +334,9 @@
     ftc_face_node_compare,  /* FTC_MruNode_CompareFunc  node_compare */
     ftc_face_node_init,     /* FTC_MruNode_InitFunc     node_init    */
     NULL,                   /* FTC_MruNode_ResetFunc    node_reset   */
-    ftc_face_node_done      /* FTC_MruNode_DoneFunc     node_done    */
+    ftc_face_node_done,     /* FTC_MruNode_DoneFunc     node_done    */
+    ftc_face_node_hash,     /* FTC_MruNode_HashFunc     node_hash    */
+    ftc_face_key_hash       /* FTC_MruKey_HashFunc      key_hash     */
   };
 
 
@@ -371,14 +412,26 @@
     if ( FT_NEW( manager ) )
       goto Exit;
 
+    if ( max_bytes == 0 )
+      max_bytes = FTC_MAX_BYTES_DEFAULT;
+
+    /* the default limits grow with the byte budget */
     if ( max_faces == 0 )
-      max_faces = FTC_MAX_FACES_DEFAULT;
+    {
+      FT_ULong  scale = max_bytes / FTC_MAX_BYTES_DEFAULT;
 
-    if ( max_sizes == 0 )
-      max_sizes = FTC_MAX_SIZES_DEFAULT;
 
-    if ( max_bytes == 0 )
-      max_bytes = FTC_MAX_BYTES_DEFAULT;
+      if ( scale < 1 )
+        scale = 1;
+      if ( scale > FTC_MAX_SCALE_DEFAULT )
+        scale = FTC_MAX_SCALE_DEFAULT;
+
+      max_faces = FTC_MAX_FACES_DEFAULT * (FT_UInt)scale;
+    }
+
+    if ( max_sizes == 0 )
+      max_sizes = max_faces * ( FTC_MAX_SIZES_DEFAULT /
+                                FTC_MAX_FACES_DEFAULT );
 
     manager->library      = library;
     manager->memory       = memory;
@@ -83,6 +83,11 @@ FT_BEGIN_HEADER
 #define FTC_MAX_SIZES_DEFAULT  4
 #define FTC_MAX_BYTES_DEFAULT  200000L  /* ~200kByte by default */
 
+  /* If `max_faces' is zero, allow FTC_MAX_FACES_DEFAULT faces per   */
+  /* FTC_MAX_BYTES_DEFAULT bytes of `max_bytes', up to this factor.  */
+  /* A zero `max_sizes' gets scaled like the number of faces.        */
+#define FTC_MAX_SCALE_DEFAULT  256
+
   /* maximum number of caches registered in a single manager */
 #define FTC_MAX_CACHES         16
 
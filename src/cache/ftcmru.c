@@ -164,6 +164,153 @@
   }
 
 
+  /* The hash index of a list is an open addressing table with linear */
+  /* probing, kept at most half full.  It is rebuilt from the list     */
+  /* when it gets too small; if that fails, lookups walk the list.     */
+
+#define FTC_MRU_SLOT( list, hash )                          \
+          ( (FT_UInt)( (hash) ^ ( (hash) >> 10 ) ) & (list)->slot_mask )
+
+
+  static void
+  ftc_mru_index_insert( FTC_MruList  list,
+                        FTC_MruNode  node,
+                        FT_Offset    hash )
+  {
+    FTC_MruSlot  slots = list->slots;
+    FT_UInt      idx   = FTC_MRU_SLOT( list, hash );
+
+
+    while ( slots[idx].node )
+      idx = ( idx + 1 ) & list->slot_mask;
+
+    slots[idx].node = node;
+    slots[idx].hash = hash;
+  }
+
+
+  static void
+  ftc_mru_index_build( FTC_MruList  list )
+  {
+    FT_Memory  memory = list->memory;
+    FT_Error   error;
+    FT_UInt    count  = 32;
+
+
+    FT_FREE( list->slots );
+    list->slot_mask = 0;
+
+    while ( count < 4 * list->num_nodes )
+      count *= 2;
+
+    if ( FT_NEW_ARRAY( list->slots, count ) )
+      return;
+
+    list->slot_mask = count - 1;
+
+    {
+      FTC_MruNode  first = list->nodes;
+      FTC_MruNode  node  = first;
+
+
+      if ( first )
+      {
+        do
+        {
+          ftc_mru_index_insert( list, node, list->clazz.node_hash( node ) );
+          node = node->next;
+
+        } while ( node != first );
+      }
+    }
+  }
+
+
+  /* call this after `node' has been added to the list */
+  static void
+  ftc_mru_index_add( FTC_MruList  list,
+                     FTC_MruNode  node )
+  {
+    if ( !list->clazz.node_hash )
+      return;
+
+    if ( !list->slots )
+    {
+      if ( list->num_nodes > FTC_MRU_INDEX_MIN )
+        ftc_mru_index_build( list );
+    }
+    else if ( 2 * list->num_nodes > list->slot_mask + 1 )
+      ftc_mru_index_build( list );
+    else
+      ftc_mru_index_insert( list, node, list->clazz.node_hash( node ) );
+  }
+
+
+  /* call this before the key of `node' changes */
+  static void
+  ftc_mru_index_remove( FTC_MruList  list,
+                        FTC_MruNode  node )
+  {
+    FTC_MruSlot  slots = list->slots;
+    FT_UInt      mask  = list->slot_mask;
+    FT_UInt      idx, next, home;
+
+
+    if ( !slots )
+      return;
+
+    idx = FTC_MRU_SLOT( list, list->clazz.node_hash( node ) );
+    while ( slots[idx].node != node )
+    {
+      if ( !slots[idx].node )
+        return;
+
+      idx = ( idx + 1 ) & mask;
+    }
+
+    /* move following entries of the probe sequence back */
+    next = idx;
+    for (;;)
+    {
+      next = ( next + 1 ) & mask;
+      if ( !slots[next].node )
+        break;
+
+      home = FTC_MRU_SLOT( list, slots[next].hash );
+
+      /* keep the entry if its home lies cyclically in ]idx,next] */
+      if ( idx <= next ? ( idx < home && home <= next )
+                       : ( idx < home || home <= next ) )
+        continue;
+
+      slots[idx] = slots[next];
+      idx        = next;
+    }
+
+    slots[idx].node = NULL;
+  }
+
+
+  FT_LOCAL_DEF( FTC_MruNode )
+  FTC_MruList_FindIndexed( FTC_MruList              list,
+                           FT_Pointer               key,
+                           FTC_MruNode_CompareFunc  compare )
+  {
+    FTC_MruSlot  slots = list->slots;
+    FT_Offset    hash  = list->clazz.key_hash( key );
+    FT_UInt      idx   = FTC_MRU_SLOT( list, hash );
+
+
+    for ( ; slots[idx].node; idx = ( idx + 1 ) & list->slot_mask )
+    {
+      if ( slots[idx].hash == hash && compare( slots[idx].node, key ) )
+        return slots[idx].node;
+    }
+
+    return NULL;
+  }
+
+
   FT_LOCAL_DEF( void )
   FTC_MruList_Init( FTC_MruList       list,
                     FTC_MruListClass  clazz,
@@ -177,16 +324,24 @@
     list->clazz     = *clazz;
     list->data      = data;
     list->memory    = memory;
+    list->slots     = NULL;
+    list->slot_mask = 0;
   }
 
 
   FT_LOCAL_DEF( void )
   FTC_MruList_Reset( FTC_MruList  list )
   {
+    FT_Memory  memory = list->memory;
+
+
     while ( list->nodes )
       FTC_MruList_Remove( list, list->nodes );
 
     FT_ASSERT( list->num_nodes == 0 );
+
+    FT_FREE( list->slots );
+    list->slot_mask = 0;
   }
 
 
@@ -209,6 +364,15 @@
     first = list->nodes;
     node  = NULL;
 
+    if ( list->slots )
+    {
+      node = FTC_MruList_FindIndexed( list, key, compare );
+      if ( node && node != first )
+        FTC_MruNode_Up( &list->nodes, node );
+
+      return node;
+    }
+
     if ( first )
     {
       node = first;
@@ -247,13 +411,20 @@
 
       FT_ASSERT( node );
 
+      ftc_mru_index_remove( list, node );
+
       if ( list->clazz.node_reset )
       {
         FTC_MruNode_Up( &list->nodes, node );
 
         error = list->clazz.node_reset( node, key, list->data );
         if ( !error )
+        {
+          if ( list->slots )
+            ftc_mru_index_insert( list, node,
+                                  list->clazz.node_hash( node ) );
           goto Exit;
+        }
       }
 
       FTC_MruNode_Remove( &list->nodes, node );
@@ -272,6 +443,8 @@
     FTC_MruNode_Prepend( &list->nodes, node );
     list->num_nodes++;
 
+    ftc_mru_index_add( list, node );
+
   Exit:
     *anode = node;
     return error;
@@ -307,6 +480,8 @@
   FTC_MruList_Remove( FTC_MruList  list,
                       FTC_MruNode  node )
   {
+    ftc_mru_index_remove( list, node );
+
     FTC_MruNode_Remove( &list->nodes, node );
     list->num_nodes--;
 
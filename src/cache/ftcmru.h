@@ -37,6 +37,10 @@
    * This is handy if `max_elements' is sufficiently small, as it saves
    * allocations/releases during the lookup process.
    *
+   * If the list class provides hash functions, a hash index of the nodes
+   * is built as soon as the list gets longer than a few elements, so that
+   * lookups don't have to walk the whole list.
+   *
    */
 
 
@@ -104,6 +108,13 @@ FT_BEGIN_HEADER
   (*FTC_MruNode_DoneFunc)( FTC_MruNode  node,
                            FT_Pointer   data );
 
+  /* the hash of a node must equal the hash of its key */
+  typedef FT_Offset
+  (*FTC_MruNode_HashFunc)( FTC_MruNode  node );
+
+  typedef FT_Offset
+  (*FTC_MruKey_HashFunc)( FT_Pointer  key );
+
 
   typedef struct  FTC_MruListClassRec_
   {
@@ -114,9 +125,25 @@ FT_BEGIN_HEADER
     FTC_MruNode_ResetFunc    node_reset;
     FTC_MruNode_DoneFunc     node_done;
 
+    /* optional; both NULL if the list shouldn't be indexed */
+    FTC_MruNode_HashFunc     node_hash;
+    FTC_MruKey_HashFunc      key_hash;
+
   } FTC_MruListClassRec;
 
 
+  /* an entry of the hash index */
+  typedef struct  FTC_MruSlotRec_
+  {
+    FTC_MruNode  node;
+    FT_Offset    hash;
+
+  } FTC_MruSlotRec, *FTC_MruSlot;
+
+  /* the index is built if a list holds more nodes than this */
+#define FTC_MRU_INDEX_MIN  8
+
+
   typedef struct  FTC_MruListRec_
   {
     FT_UInt              num_nodes;
@@ -126,6 +153,9 @@ FT_BEGIN_HEADER
     FTC_MruListClassRec  clazz;
     FT_Memory            memory;
 
+    FTC_MruSlot          slots;      /* open hash index, or NULL */
+    FT_UInt              slot_mask;  /* number of slots minus 1  */
+
   } FTC_MruListRec;
 
 
@@ -158,6 +188,11 @@ FT_BEGIN_HEADER
                                FTC_MruNode_CompareFunc  selection,
                                FT_Pointer               key );
 
+  FT_LOCAL( FTC_MruNode )
+  FTC_MruList_FindIndexed( FTC_MruList              list,
+                           FT_Pointer               key,
+                           FTC_MruNode_CompareFunc  compare );
+
 
 #ifdef FTC_INLINE
 
@@ -172,7 +207,19 @@ FT_BEGIN_HEADER
     _first = *(_pfirst);                                                    \
     _node  = NULL;                                                          \
                                                                             \
-    if ( _first )                                                           \
+    if ( (list)->slots )                                                    \
+    {                                                                       \
+      _node = FTC_MruList_FindIndexed( (list), (key), _compare );           \
+      if ( _node )                                                          \
+      {                                                                     \
+        if ( _node != _first )                                              \
+          FTC_MruNode_Up( _pfirst, _node );                                 \
+                                                                            \
+        node = _node;                                                       \
+        goto MruOk_;                                                        \
+      }                                                                     \
+    }                                                                       \
+    else if ( _first )                                                      \
     {                                                                       \
       _node = _first;                                                       \
       do                                                                    \
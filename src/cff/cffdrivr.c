@@ -27,6 +27,7 @@
 #include <freetype/internal/services/svpostnm.h>
 #include <freetype/internal/services/svttcmap.h>
 #include <freetype/internal/services/svcfftl.h>
+#include <freetype/internal/services/svpurge.h>
 
 #include "cffdrivr.h"
 #include "cffgload.h"
@@ -379,6 +380,29 @@
   }
 
 
+  static FT_String*
+  cff_get_sid_name( CFF_Font            cff,
+                    FT_Service_PsCMaps  psnames,
+                    FT_UShort           sid )
+  {
+    if ( sid > 390 )
+      return cff_index_get_string( cff, sid - 391 );
+    else
+      return (FT_String *)psnames->adobe_std_strings( sid );
+  }
+
+
+  static const char*
+  cff_get_glyph_sid_name( void*    cff_,
+                          FT_UInt  idx )
+  {
+    CFF_Font  cff = (CFF_Font)cff_;
+
+
+    return cff_get_sid_name( cff, cff->psnames, cff->charset.sids[idx] );
+  }
+
+
   static FT_UInt
   cff_get_name_index( CFF_Face          face,
                       const FT_String*  glyph_name )
@@ -387,7 +411,6 @@
     CFF_Charset         charset;
     FT_Service_PsCMaps  psnames;
     FT_String*          name;
-    FT_UShort           sid;
     FT_UInt             i;
 
 
@@ -423,15 +446,21 @@
     if ( !psnames )
       return 0;
 
-    for ( i = 0; i < cff->num_glyphs; i++ )
+    if ( cff->name_hash                                     ||
+         !ft_hash_str_new_names( &cff->name_hash, cff->num_glyphs,
+                                 cff_get_glyph_sid_name, cff,
+                                 cff->memory )                  )
     {
-      sid = charset->sids[i];
+      size_t*  gid = ft_hash_str_lookup( glyph_name, cff->name_hash );
 
-      if ( sid > 390 )
-        name = cff_index_get_string( cff, sid - 391 );
-      else
-        name = (FT_String *)psnames->adobe_std_strings( sid );
 
+      return gid ? (FT_UInt)*gid : 0;
+    }
+
+    /* out of memory; fall back to a linear search */
+    for ( i = 0; i < cff->num_glyphs; i++ )
+    {
+      name = cff_get_sid_name( cff, psnames, charset->sids[i] );
       if ( !name )
         continue;
 
@@ -951,7 +980,10 @@
     (FT_Get_MM_WeightVector_Func)cff_get_mm_weightvector, /* get_mm_weightvector */
 
     (FT_Get_Var_Blend_Func)      cff_get_var_blend,       /* get_var_blend       */
-    (FT_Done_Blend_Func)         cff_done_blend           /* done_blend          */
+    (FT_Done_Blend_Func)         cff_done_blend,          /* done_blend          */
+
+    (FT_Set_Size_Var_Func)       NULL,                    /* set_size_mm_blend   */
+    (FT_Set_Size_Var_Func)       NULL                     /* set_size_var_design */
   )
 
 
@@ -1015,6 +1047,39 @@
   )
 
 
+  /*
+   * PURGE SERVICE
+   *
+   */
+
+  static void
+  cff_face_purge( FT_Face  face )       /* CFF_Face */
+  {
+    CFF_Face      cffface = (CFF_Face)face;
+    CFF_Font      cff     = (CFF_Font)cffface->extra.data;
+    SFNT_Service  sfnt    = (SFNT_Service)cffface->sfnt;
+    FT_Memory     memory  = face->memory;
+
+
+    /* the glyph name hash is rebuilt by the next `FT_Get_Name_Index' */
+    if ( cff && cff->name_hash )
+    {
+      ft_hash_str_free( cff->name_hash, memory );
+      FT_FREE( cff->name_hash );
+    }
+
+    if ( sfnt && sfnt->free_psnames )
+      sfnt->free_psnames( cffface );
+  }
+
+
+  FT_DEFINE_SERVICE_PURGEREC(
+    cff_service_purge,
+
+    (FT_Purge_Func)cff_face_purge    /* purge */
+  )
+
+
   /*************************************************************************/
   /*************************************************************************/
   /*************************************************************************/
@@ -1029,7 +1094,7 @@
 
 #if !defined FT_CONFIG_OPTION_NO_GLYPH_NAMES && \
      defined TT_CONFIG_OPTION_GX_VAR_SUPPORT
-  FT_DEFINE_SERVICEDESCREC10(
+  FT_DEFINE_SERVICEDESCREC11(
     cff_services,
 
     FT_SERVICE_ID_FONT_FORMAT,          FT_FONT_FORMAT_CFF,
@@ -1041,10 +1106,11 @@
     FT_SERVICE_ID_TT_CMAP,              &cff_service_get_cmap_info,
     FT_SERVICE_ID_CID,                  &cff_service_cid_info,
     FT_SERVICE_ID_PROPERTIES,           &cff_service_properties,
-    FT_SERVICE_ID_CFF_LOAD,             &cff_service_cff_load
+    FT_SERVICE_ID_CFF_LOAD,             &cff_service_cff_load,
+    FT_SERVICE_ID_PURGE,                &cff_service_purge
   )
 #elif !defined FT_CONFIG_OPTION_NO_GLYPH_NAMES
-  FT_DEFINE_SERVICEDESCREC8(
+  FT_DEFINE_SERVICEDESCREC9(
     cff_services,
 
     FT_SERVICE_ID_FONT_FORMAT,          FT_FONT_FORMAT_CFF,
@@ -1054,10 +1120,11 @@
     FT_SERVICE_ID_TT_CMAP,              &cff_service_get_cmap_info,
     FT_SERVICE_ID_CID,                  &cff_service_cid_info,
     FT_SERVICE_ID_PROPERTIES,           &cff_service_properties,
-    FT_SERVICE_ID_CFF_LOAD,             &cff_service_cff_load
+    FT_SERVICE_ID_CFF_LOAD,             &cff_service_cff_load,
+    FT_SERVICE_ID_PURGE,                &cff_service_purge
   )
 #elif defined TT_CONFIG_OPTION_GX_VAR_SUPPORT
-  FT_DEFINE_SERVICEDESCREC9(
+  FT_DEFINE_SERVICEDESCREC10(
     cff_services,
 
     FT_SERVICE_ID_FONT_FORMAT,          FT_FONT_FORMAT_CFF,
@@ -1068,10 +1135,11 @@
     FT_SERVICE_ID_TT_CMAP,              &cff_service_get_cmap_info,
     FT_SERVICE_ID_CID,                  &cff_service_cid_info,
     FT_SERVICE_ID_PROPERTIES,           &cff_service_properties,
-    FT_SERVICE_ID_CFF_LOAD,             &cff_service_cff_load
+    FT_SERVICE_ID_CFF_LOAD,             &cff_service_cff_load,
+    FT_SERVICE_ID_PURGE,                &cff_service_purge
   )
 #else
-  FT_DEFINE_SERVICEDESCREC7(
+  FT_DEFINE_SERVICEDESCREC8(
     cff_services,
 
     FT_SERVICE_ID_FONT_FORMAT,          FT_FONT_FORMAT_CFF,
@@ -1080,7 +1148,8 @@
     FT_SERVICE_ID_TT_CMAP,              &cff_service_get_cmap_info,
     FT_SERVICE_ID_CID,                  &cff_service_cid_info,
     FT_SERVICE_ID_PROPERTIES,           &cff_service_properties,
-    FT_SERVICE_ID_CFF_LOAD,             &cff_service_cff_load
+    FT_SERVICE_ID_CFF_LOAD,             &cff_service_cff_load,
+    FT_SERVICE_ID_PURGE,                &cff_service_purge
   )
 #endif
 
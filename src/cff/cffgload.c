@@ -52,10 +52,9 @@
     if ( face->root.internal->incremental_interface )
     {
       FT_Data   data;
-      FT_Error  error =
-                  face->root.internal->incremental_interface->funcs->get_glyph_data(
-                    face->root.internal->incremental_interface->object,
-                    glyph_index, &data );
+      FT_Error  error = ft_incremental_get_glyph_data( FT_FACE( face ),
+                                                       glyph_index,
+                                                       &data );
 
 
       *pointer = (FT_Byte*)data.pointer;
@@ -111,85 +110,6 @@
   }
 
 
-  /*************************************************************************/
-  /*************************************************************************/
-  /*************************************************************************/
-  /**********                                                      *********/
-  /**********                                                      *********/
-  /**********            COMPUTE THE MAXIMUM ADVANCE WIDTH         *********/
-  /**********                                                      *********/
-  /**********    The following code is in charge of computing      *********/
-  /**********    the maximum advance width of the font.  It        *********/
-  /**********    quickly processes each glyph charstring to        *********/
-  /**********    extract the value from either a `sbw' or `seac'   *********/
-  /**********    operator.                                         *********/
-  /**********                                                      *********/
-  /*************************************************************************/
-  /*************************************************************************/
-  /*************************************************************************/
-
-
-#if 0 /* unused until we support pure CFF fonts */
-
-
-  FT_LOCAL_DEF( FT_Error )
-  cff_compute_max_advance( TT_Face  face,
-                           FT_Int*  max_advance )
-  {
-    FT_Error     error = FT_Err_Ok;
-    CFF_Decoder  decoder;
-    FT_Int       glyph_index;
-    CFF_Font     cff = (CFF_Font)face->other;
-
-    PSAux_Service            psaux         = (PSAux_Service)face->psaux;
-    const CFF_Decoder_Funcs  decoder_funcs = psaux->cff_decoder_funcs;
-
-
-    *max_advance = 0;
-
-    /* Initialize load decoder */
-    decoder_funcs->init( &decoder, face, 0, 0, 0, 0, 0, 0 );
-
-    decoder.builder.metrics_only = 1;
-    decoder.builder.load_points  = 0;
-
-    /* For each glyph, parse the glyph charstring and extract */
-    /* the advance width.                                     */
-    for ( glyph_index = 0; glyph_index < face->root.num_glyphs;
-          glyph_index++ )
-    {
-      FT_Byte*  charstring;
-      FT_ULong  charstring_len;
-
-
-      /* now get load the unscaled outline */
-      error = cff_get_glyph_data( face, glyph_index,
-                                  &charstring, &charstring_len );
-      if ( !error )
-      {
-        error = decoder_funcs->prepare( &decoder, size, glyph_index );
-        if ( !error )
-          error = decoder_funcs->parse_charstrings_old( &decoder,
-                                                        charstring,
-                                                        charstring_len,
-                                                        0 );
-
-        cff_free_glyph_data( face, &charstring, &charstring_len );
-      }
-
-      /* ignore the error if one has occurred -- skip to next glyph */
-      error = FT_Err_Ok;
-    }
-
-    *max_advance = decoder.builder.advance.x;
-
-    return FT_Err_Ok;
-  }
-
-
-#endif /* 0 */
-
-
   FT_LOCAL_DEF( FT_Error )
   cff_slot_load( CFF_GlyphSlot  glyph,
                  CFF_Size       size,
@@ -2533,6 +2533,13 @@
     FT_UInt    idx;
 
 
+    /* the hash keys point into the string pool, so free it first */
+    if ( font->name_hash )
+    {
+      ft_hash_str_free( font->name_hash, memory );
+      FT_FREE( font->name_hash );
+    }
+
     cff_index_done( &font->global_subrs_index );
     cff_index_done( &font->font_dict_index );
     cff_index_done( &font->name_index );
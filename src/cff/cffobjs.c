@@ -550,6 +550,10 @@
     /* check whether we have a valid OpenType file */
     FT_TRACE2(( "  " ));
     error = sfnt->init_face( stream, face, face_index, num_params, params );
+
+    /* Stream may have changed. */
+    stream = face->root.stream;
+
     if ( !error )
     {
       if ( face->format_tag != TTAG_OTTO )  /* `OTTO'; OpenType/CFF font */
@@ -74,8 +74,8 @@
       FT_Data  glyph_data;
 
 
-      error = inc->funcs->get_glyph_data( inc->object,
-                                          glyph_index, &glyph_data );
+      error = ft_incremental_get_glyph_data( FT_FACE( face ),
+                                             glyph_index, &glyph_data );
       if ( error )
         goto Exit;
 
@@ -146,6 +146,11 @@
       FT_UInt       cs_offset;
 
 
+      /* Load the font dict's subrs if not done yet. */
+      error = cid_load_subrs( face, (FT_UInt)fd_select );
+      if ( error )
+        goto Exit;
+
       /* Set up subrs */
       decoder->num_subrs  = cid_subrs->num_subrs;
       decoder->subrs      = cid_subrs->code;
@@ -259,79 +264,6 @@
   }
 
 
-#if 0
-
-
-  /*************************************************************************/
-  /*************************************************************************/
-  /*************************************************************************/
-  /**********                                                      *********/
-  /**********                                                      *********/
-  /**********            COMPUTE THE MAXIMUM ADVANCE WIDTH         *********/
-  /**********                                                      *********/
-  /**********    The following code is in charge of computing      *********/
-  /**********    the maximum advance width of the font.  It        *********/
-  /**********    quickly processes each glyph charstring to        *********/
-  /**********    extract the value from either a `sbw' or `seac'   *********/
-  /**********    operator.                                         *********/
-  /**********                                                      *********/
-  /*************************************************************************/
-  /*************************************************************************/
-  /*************************************************************************/
-
-
-  FT_LOCAL_DEF( FT_Error )
-  cid_face_compute_max_advance( CID_Face  face,
-                                FT_Int*   max_advance )
-  {
-    FT_Error       error;
-    T1_DecoderRec  decoder;
-    FT_Int         glyph_index;
-
-    PSAux_Service  psaux = (PSAux_Service)face->psaux;
-
-
-    *max_advance = 0;
-
-    /* Initialize load decoder */
-    error = psaux->t1_decoder_funcs->init( &decoder,
-                                           (FT_Face)face,
-                                           0, /* size       */
-                                           0, /* glyph slot */
-                                           0, /* glyph names! XXX */
-                                           0, /* blend == 0 */
-                                           0, /* hinting == 0 */
-                                           cid_load_glyph );
-    if ( error )
-      return error;
-
-    /* TODO: initialize decoder.len_buildchar and decoder.buildchar */
-    /*       if we ever support CID-keyed multiple master fonts     */
-
-    decoder.builder.metrics_only = 1;
-    decoder.builder.load_points  = 0;
-
-    /* for each glyph, parse the glyph charstring and extract */
-    /* the advance width                                      */
-    for ( glyph_index = 0; glyph_index < face->root.num_glyphs;
-          glyph_index++ )
-    {
-      /* now get load the unscaled outline */
-      error = cid_load_glyph( &decoder, glyph_index );
-      /* ignore the error if one occurred - skip to next glyph */
-    }
-
-    *max_advance = FIXED_TO_INT( decoder.builder.advance.x );
-
-    psaux->t1_decoder_funcs->done( &decoder );
-
-    return FT_Err_Ok;
-  }
-
-
-#endif /* 0 */
-
-
   FT_LOCAL_DEF( FT_Error )
   cid_slot_load_glyph( FT_GlyphSlot  cidglyph,      /* CID_GlyphSlot */
                        FT_Size       cidsize,       /* CID_Size      */
@@ -26,15 +26,6 @@
 FT_BEGIN_HEADER
 
 
-#if 0
-
-  /* Compute the maximum advance width of a font through quick parsing */
-  FT_LOCAL( FT_Error )
-  cid_face_compute_max_advance( CID_Face  face,
-                                FT_Int*   max_advance );
-
-#endif /* 0 */
-
   FT_LOCAL( FT_Error )
   cid_slot_load_glyph( FT_GlyphSlot  glyph,         /* CID_Glyph_Slot */
                        FT_Size       size,          /* CID_Size       */
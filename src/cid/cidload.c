@@ -509,136 +509,110 @@
   }
 
 
-  /* read the subrmap and the subrs of each font dict */
-  static FT_Error
-  cid_read_subrs( CID_Face  face )
+  /* read the subrmap and the subrs of a font dict; this is done */
+  /* when a glyph of the font dict gets loaded the first time     */
+  FT_LOCAL_DEF( FT_Error )
+  cid_load_subrs( CID_Face  face,
+                  FT_UInt   fd_index )
   {
     CID_FaceInfo   cid    = &face->cid;
     FT_Memory      memory = face->root.memory;
     FT_Stream      stream = face->cid_stream;
     FT_Error       error;
-    FT_Int         n;
-    CID_Subrs      subr;
-    FT_UInt        max_offsets = 0;
+    CID_Subrs      subr   = face->subrs + fd_index;
+    CID_FaceDict   dict   = cid->font_dicts + fd_index;
+    FT_Int         lenIV;
+    FT_UInt        count, num_subrs;
+    FT_ULong       data_len;
     FT_ULong*      offsets = NULL;
+    FT_Byte*       p;
     PSAux_Service  psaux = (PSAux_Service)face->psaux;
 
 
-    if ( FT_NEW_ARRAY( face->subrs, cid->num_dicts ) )
-      goto Exit;
-
-    subr = face->subrs;
-    for ( n = 0; n < cid->num_dicts; n++, subr++ )
-    {
-      CID_FaceDict  dict  = cid->font_dicts + n;
-      FT_Int        lenIV = dict->private_dict.lenIV;
-      FT_UInt       count, num_subrs = dict->num_subrs;
-      FT_ULong      data_len;
-      FT_Byte*      p;
-
-
-      if ( !num_subrs )
-        continue;
+    if ( fd_index >= (FT_UInt)cid->num_dicts )
+      return FT_THROW( Invalid_Argument );
 
-      /* reallocate offsets array if needed */
-      if ( num_subrs + 1 > max_offsets )
-      {
-        FT_UInt  new_max = FT_PAD_CEIL( num_subrs + 1, 4 );
-
-
-        if ( new_max <= max_offsets )
-        {
-          error = FT_THROW( Syntax_Error );
-          goto Fail;
-        }
+    lenIV     = dict->private_dict.lenIV;
+    num_subrs = dict->num_subrs;
 
-        if ( FT_RENEW_ARRAY( offsets, max_offsets, new_max ) )
-          goto Fail;
-
-        max_offsets = new_max;
-      }
+    if ( subr->code || !num_subrs )
+      return FT_Err_Ok;
 
-      /* read the subrmap's offsets */
-      if ( FT_STREAM_SEEK( cid->data_offset + dict->subrmap_offset )     ||
-           FT_FRAME_ENTER( ( num_subrs + 1 ) * (FT_UInt)dict->sd_bytes ) )
-        goto Fail;
+    if ( FT_NEW_ARRAY( offsets, (FT_ULong)num_subrs + 1 ) )
+      goto Exit;
 
-      p = (FT_Byte*)stream->cursor;
-      for ( count = 0; count <= num_subrs; count++ )
-        offsets[count] = cid_get_offset( &p, (FT_Byte)dict->sd_bytes );
+    /* read the subrmap's offsets */
+    if ( FT_STREAM_SEEK( cid->data_offset + dict->subrmap_offset )     ||
+         FT_FRAME_ENTER( ( num_subrs + 1 ) * (FT_UInt)dict->sd_bytes ) )
+      goto Exit;
 
-      FT_FRAME_EXIT();
+    p = (FT_Byte*)stream->cursor;
+    for ( count = 0; count <= num_subrs; count++ )
+      offsets[count] = cid_get_offset( &p, (FT_Byte)dict->sd_bytes );
 
-      /* offsets must be ordered */
-      for ( count = 1; count <= num_subrs; count++ )
-        if ( offsets[count - 1] > offsets[count] )
-        {
-          FT_ERROR(( "cid_read_subrs: offsets are not ordered\n" ));
-          error = FT_THROW( Invalid_File_Format );
-          goto Fail;
-        }
+    FT_FRAME_EXIT();
 
-      if ( offsets[num_subrs] > stream->size - cid->data_offset )
+    /* offsets must be ordered */
+    for ( count = 1; count <= num_subrs; count++ )
+      if ( offsets[count - 1] > offsets[count] )
       {
-        FT_ERROR(( "cid_read_subrs: too large `subrs' offsets\n" ));
+        FT_ERROR(( "cid_load_subrs: offsets are not ordered\n" ));
         error = FT_THROW( Invalid_File_Format );
-        goto Fail;
+        goto Exit;
       }
 
-      /* now, compute the size of subrs charstrings, */
-      /* allocate, and read them                     */
-      data_len = offsets[num_subrs] - offsets[0];
+    if ( offsets[num_subrs] > stream->size - cid->data_offset )
+    {
+      FT_ERROR(( "cid_load_subrs: too large `subrs' offsets\n" ));
+      error = FT_THROW( Invalid_File_Format );
+      goto Exit;
+    }
+
+    /* now, compute the size of subrs charstrings, */
+    /* allocate, and read them                     */
+    data_len = offsets[num_subrs] - offsets[0];
 
-      if ( FT_NEW_ARRAY( subr->code, num_subrs + 1 ) ||
-           FT_ALLOC( subr->code[0], data_len )       )
-        goto Fail;
+    if ( FT_NEW_ARRAY( subr->code, num_subrs + 1 ) ||
+         FT_ALLOC( subr->code[0], data_len )       )
+      goto Fail;
 
-      if ( FT_STREAM_SEEK( cid->data_offset + offsets[0] ) ||
-           FT_STREAM_READ( subr->code[0], data_len )  )
-        goto Fail;
+    if ( FT_STREAM_SEEK( cid->data_offset + offsets[0] ) ||
+         FT_STREAM_READ( subr->code[0], data_len )  )
+      goto Fail;
 
-      /* set up pointers */
-      for ( count = 1; count <= num_subrs; count++ )
-      {
-        FT_ULong  len;
+    /* set up pointers */
+    for ( count = 1; count <= num_subrs; count++ )
+    {
+      FT_ULong  len;
 
 
-        len               = offsets[count] - offsets[count - 1];
-        subr->code[count] = subr->code[count - 1] + len;
-      }
+      len               = offsets[count] - offsets[count - 1];
+      subr->code[count] = subr->code[count - 1] + len;
+    }
 
-      /* decrypt subroutines, but only if lenIV >= 0 */
-      if ( lenIV >= 0 )
+    /* decrypt subroutines, but only if lenIV >= 0 */
+    if ( lenIV >= 0 )
+    {
+      for ( count = 0; count < num_subrs; count++ )
       {
-        for ( count = 0; count < num_subrs; count++ )
-        {
-          FT_ULong  len;
+        FT_ULong  len;
 
 
-          len = offsets[count + 1] - offsets[count];
-          psaux->t1_decrypt( subr->code[count], len, 4330 );
-        }
+        len = offsets[count + 1] - offsets[count];
+        psaux->t1_decrypt( subr->code[count], len, 4330 );
       }
-
-      subr->num_subrs = (FT_Int)num_subrs;
     }
 
+    subr->num_subrs = (FT_Int)num_subrs;
+
   Exit:
     FT_FREE( offsets );
     return error;
 
   Fail:
-    if ( face->subrs )
-    {
-      for ( n = 0; n < cid->num_dicts; n++ )
-      {
-        if ( face->subrs[n].code )
-          FT_FREE( face->subrs[n].code[0] );
-
-        FT_FREE( face->subrs[n].code );
-      }
-      FT_FREE( face->subrs );
-    }
+    if ( subr->code )
+      FT_FREE( subr->code[0] );
+    FT_FREE( subr->code );
     goto Exit;
   }
 
@@ -664,98 +638,246 @@
   }
 
 
-  static FT_Error
-  cid_hex_to_binary( FT_Byte*  data,
-                     FT_ULong  data_len,
-                     FT_ULong  offset,
-                     CID_Face  face )
+  /*************************************************************************/
+  /*                                                                       */
+  /* A data section in hexadecimal format is accessed through a stream    */
+  /* that decodes it on demand.  To avoid rescanning the data from the    */
+  /* start for every read, we record the source position of every         */
+  /* `CID_HEX_BLOCK_SIZE' bytes of binary data; the index grows as far as */
+  /* the data has been accessed.                                          */
+  /*                                                                       */
+
+#define CID_HEX_BLOCK_SIZE  1024
+
+
+  typedef struct  CID_HexStreamRec_
   {
-    FT_Stream  stream = face->root.stream;
-    FT_Error   error;
+    FT_Memory  memory;
+    FT_Stream  source;
 
-    FT_Byte    buffer[256];
-    FT_Byte   *p, *plimit;
-    FT_Byte   *d, *dlimit;
-    FT_Byte    val;
+    FT_ULong   num_blocks;  /* number of known block positions */
+    FT_ULong   max_blocks;
+    FT_ULong*  blocks;      /* source position of each block   */
 
-    FT_Bool    upper_nibble, done;
+    FT_Bool    closed;      /* last processing stopped at `>'  */
 
+  } CID_HexStreamRec, *CID_HexStream;
 
-    if ( FT_STREAM_SEEK( offset ) )
-      goto Exit;
 
-    d      = data;
-    dlimit = d + data_len;
-    p      = buffer;
-    plimit = p;
+  /* Process up to `num_digits' hex digits of the source stream,        */
+  /* starting at `*apos'.  If `buffer' is not NULL, store the decoded   */
+  /* nibbles there; it must be zeroed by the caller.  Return the number */
+  /* of digits processed, which is less than `num_digits' if the end of */
+  /* the data (`>', an invalid character, or the end of the stream) is  */
+  /* reached; `hex->closed' tells whether it was a regular `>'.         */
+  static FT_ULong
+  cid_hex_stream_process( CID_HexStream  hex,
+                          FT_ULong*      apos,
+                          FT_ULong       num_digits,
+                          FT_Byte*       buffer )
+  {
+    FT_Stream  source = hex->source;
+    FT_ULong   pos    = *apos;
+    FT_ULong   done   = 0;
+
+    FT_Byte    chunk[256];
+
 
-    upper_nibble = 1;
-    done         = 0;
+    hex->closed = FALSE;
 
-    while ( d < dlimit )
+    while ( done < num_digits && pos < source->size )
     {
-      if ( p >= plimit )
+      FT_ULong  size = source->size - pos;
+      FT_ULong  n;
+
+
+      if ( size > sizeof ( chunk ) )
+        size = sizeof ( chunk );
+
+      if ( FT_Stream_ReadAt( source, pos, chunk, size ) )
+        break;
+
+      for ( n = 0; n < size && done < num_digits; n++ )
       {
-        FT_ULong  oldpos = FT_STREAM_POS();
-        FT_ULong  size   = stream->size - oldpos;
+        FT_Byte  c = chunk[n];
+        FT_Byte  val;
+
+
+        if ( ft_isdigit( c ) )
+          val = (FT_Byte)( c - '0' );
+        else if ( c >= 'a' && c <= 'f' )
+          val = (FT_Byte)( c - 'a' + 10 );
+        else if ( c >= 'A' && c <= 'F' )
+          val = (FT_Byte)( c - 'A' + 10 );
+        else if ( c == ' '  ||
+                  c == '\t' ||
+                  c == '\r' ||
+                  c == '\n' ||
+                  c == '\f' ||
+                  c == '\0' )
+          continue;
+        else
+        {
+          if ( c == '>' )
+          {
+            FT_TRACE2(( "cid_hex_stream_process: end of hex data\n" ));
+            hex->closed = TRUE;
+          }
+          else
+            FT_ERROR(( "cid_hex_stream_process:"
+                       " invalid character in hex data\n" ));
 
+          *apos = pos + n;
+          return done;
+        }
 
-        if ( size == 0 )
+        if ( buffer )
         {
-          error = FT_THROW( Syntax_Error );
-          goto Exit;
+          if ( done & 1 )
+            buffer[done >> 1] |= val;
+          else
+            buffer[done >> 1] = (FT_Byte)( val << 4 );
         }
 
-        if ( FT_STREAM_READ( buffer, 256 > size ? size : 256 ) )
-          goto Exit;
-        p      = buffer;
-        plimit = p + FT_STREAM_POS() - oldpos;
+        done++;
       }
 
-      if ( ft_isdigit( *p ) )
-        val = (FT_Byte)( *p - '0' );
-      else if ( *p >= 'a' && *p <= 'f' )
-        val = (FT_Byte)( *p - 'a' + 10 );
-      else if ( *p >= 'A' && *p <= 'F' )
-        val = (FT_Byte)( *p - 'A' + 10 );
-      else if ( *p == ' '  ||
-                *p == '\t' ||
-                *p == '\r' ||
-                *p == '\n' ||
-                *p == '\f' ||
-                *p == '\0' )
-      {
-        p++;
-        continue;
-      }
-      else if ( *p == '>' )
-      {
-        val  = 0;
-        done = 1;
-      }
-      else
+      pos += n;
+    }
+
+    *apos = pos;
+    return done;
+  }
+
+
+  /* The stream's `read' function.  As with a memory-based copy of the */
+  /* data, the bytes after a `>' that ends the data early are zero.  A  */
+  /* read that hits invalid or truncated data, or runs out of memory,   */
+  /* returns fewer bytes, making `FT_Stream_Read' and friends fail.     */
+  static unsigned long
+  cid_hex_stream_io( FT_Stream       stream,
+                     unsigned long   offset,
+                     unsigned char*  buffer,
+                     unsigned long   count )
+  {
+    CID_HexStream  hex    = (CID_HexStream)stream->descriptor.pointer;
+    FT_Memory      memory = hex->memory;
+    FT_Error       error;
+
+    FT_ULong  block, pos, skip, digits;
+
+
+    if ( !count )
+      return offset > stream->size;
+
+    if ( offset >= stream->size )
+      return 0;
+
+    if ( count > stream->size - offset )
+      count = stream->size - offset;
+
+    FT_MEM_ZERO( buffer, count );
+
+    /* extend the block index as far as needed */
+    block = offset / CID_HEX_BLOCK_SIZE;
+
+    while ( hex->num_blocks <= block )
+    {
+      pos = hex->blocks[hex->num_blocks - 1];
+
+      if ( cid_hex_stream_process( hex,
+                                   &pos,
+                                   2 * CID_HEX_BLOCK_SIZE,
+                                   NULL ) < 2 * CID_HEX_BLOCK_SIZE )
       {
-        error = FT_THROW( Syntax_Error );
-        goto Exit;
+        if ( !hex->closed )
+          return 0;
+
+        /* the requested bytes follow the final `>' */
+        return count;
       }
 
-      if ( upper_nibble )
-        *d = (FT_Byte)( val << 4 );
-      else
+      if ( hex->num_blocks == hex->max_blocks )
       {
-        *d = (FT_Byte)( *d + val );
-        d++;
+        FT_ULong  new_max = 2 * hex->max_blocks;
+
+
+        if ( FT_RENEW_ARRAY( hex->blocks, hex->max_blocks, new_max ) )
+        {
+          FT_TRACE2(( "cid_hex_stream_io: out of memory\n" ));
+          return 0;
+        }
+
+        hex->max_blocks = new_max;
       }
 
-      upper_nibble = (FT_Byte)( 1 - upper_nibble );
+      hex->blocks[hex->num_blocks++] = pos;
+    }
+
+    pos  = hex->blocks[block];
+    skip = 2 * ( offset - block * CID_HEX_BLOCK_SIZE );
+
+    if ( cid_hex_stream_process( hex, &pos, skip, NULL ) < skip )
+      return hex->closed ? count : 0;
+
+    digits = cid_hex_stream_process( hex, &pos, 2 * count, buffer );
+    if ( digits < 2 * count && !hex->closed )
+      return digits / 2;
+
+    return count;
+  }
+
+
+  static void
+  cid_hex_stream_close( FT_Stream  stream )
+  {
+    CID_HexStream  hex    = (CID_HexStream)stream->descriptor.pointer;
+    FT_Memory      memory = hex->memory;
+
+
+    FT_FREE( hex->blocks );
+    FT_FREE( hex );
+
+    stream->descriptor.pointer = NULL;
+    stream->read               = NULL;
+    stream->close              = NULL;
+  }
 
-      if ( done )
-        break;
 
-      p++;
+  /* set up `face->cid_stream' to decode the hex data section */
+  static FT_Error
+  cid_hex_stream_init( CID_Face  face,
+                       FT_ULong  offset,
+                       FT_ULong  length )
+  {
+    FT_Memory      memory = face->root.memory;
+    FT_Stream      stream = face->cid_stream;
+    CID_HexStream  hex    = NULL;
+    FT_Error       error;
+
+
+    if ( FT_NEW( hex ) )
+      goto Exit;
+
+    if ( FT_QNEW_ARRAY( hex->blocks, 16 ) )
+    {
+      FT_FREE( hex );
+      goto Exit;
     }
 
-    error = FT_Err_Ok;
+    hex->memory     = memory;
+    hex->source     = face->root.stream;
+    hex->num_blocks = 1;
+    hex->max_blocks = 16;
+    hex->blocks[0]  = offset;
+
+    stream->base               = NULL;
+    stream->size               = length;
+    stream->pos                = 0;
+    stream->descriptor.pointer = hex;
+    stream->read               = cid_hex_stream_io;
+    stream->close              = cid_hex_stream_close;
+    stream->memory             = memory;
 
   Exit:
     return error;
@@ -811,22 +933,22 @@
                                 parser->data_offset;
       }
 
-      /* we must convert the data section from hexadecimal to binary */
-      if ( FT_ALLOC( face->binary_data, parser->binary_length )    ||
-           FT_SET_ERROR( cid_hex_to_binary( face->binary_data,
-                                            parser->binary_length,
-                                            parser->data_offset,
-                                            face ) )               )
+      /* the data section gets converted from hexadecimal on demand */
+      error = cid_hex_stream_init( face,
+                                   parser->data_offset,
+                                   parser->binary_length );
+      if ( error )
         goto Exit;
 
-      FT_Stream_OpenMemory( face->cid_stream,
-                            face->binary_data, parser->binary_length );
       cid->data_offset = 0;
     }
     else
     {
       *face->cid_stream = *face->root.stream;
       cid->data_offset  = loader.parser.data_offset;
+
+      /* the copy must not close the font file */
+      face->cid_stream->close = NULL;
     }
 
     /* sanity tests */
@@ -929,8 +1051,9 @@
       goto Exit;
     }
 
-    /* we can now safely proceed */
-    error = cid_read_subrs( face );
+    /* the subrs of each font dict are loaded on demand */
+    if ( FT_NEW_ARRAY( face->subrs, cid->num_dicts ) )
+      goto Exit;
 
   Exit:
     cid_done_loader( &loader );
@@ -43,6 +43,10 @@ FT_BEGIN_HEADER
   cid_face_open( CID_Face  face,
                  FT_Int    face_index );
 
+  FT_LOCAL( FT_Error )
+  cid_load_subrs( CID_Face  face,
+                  FT_UInt   fd_index );
+
 
 FT_END_HEADER
 
@@ -249,6 +249,9 @@
     cidface->style_name  = NULL;
 
     FT_FREE( face->binary_data );
+
+    /* release the hex data decoder, if any */
+    FT_Stream_Close( face->cid_stream );
     FT_FREE( face->cid_stream );
   }
 
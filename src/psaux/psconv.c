@@ -490,6 +490,28 @@
       FT_UInt  c = p[r];
 
 
+      /* fast path for two adjacent digits starting a new byte, */
+      /* which is the normal case                               */
+      if ( pad == 0x01 && r + 1 < n )
+      {
+        FT_UInt  c2 = p[r + 1];
+
+
+        if ( !( c OP 0x80 ) && !( c2 OP 0x80 ) )
+        {
+          FT_UInt  hi = (FT_UInt)ft_char_table[c & 0x7F];
+          FT_UInt  lo = (FT_UInt)ft_char_table[c2 & 0x7F];
+
+
+          if ( hi < 16 && lo < 16 )
+          {
+            buffer[w++] = (FT_Byte)( ( hi << 4 ) | lo );
+            r++;
+            continue;
+          }
+        }
+      }
+
       if ( IS_PS_SPACE( c ) )
         continue;
 
@@ -735,8 +735,8 @@
     /* For incremental fonts get the character data using the */
     /* callback function.                                     */
     if ( inc )
-      error = inc->funcs->get_glyph_data( inc->object,
-                                          glyph_index, &glyph_data );
+      error = ft_incremental_get_glyph_data( FT_FACE( face ),
+                                             glyph_index, &glyph_data );
     else
 #endif
     /* For ordinary fonts get the character data stored in the face record. */
@@ -180,11 +180,26 @@
   }
 
 
+  static const char*
+  sfnt_get_glyph_ps_name( void*    face,
+                          FT_UInt  idx )
+  {
+    FT_String*  gname;
+
+
+    if ( tt_face_get_ps_name( (TT_Face)face, idx, &gname ) )
+      return NULL;
+
+    return gname;
+  }
+
+
   static FT_UInt
   sfnt_get_name_index( FT_Face           face,
                        const FT_String*  glyph_name )
   {
-    TT_Face  ttface = (TT_Face)face;
+    TT_Face        ttface = (TT_Face)face;
+    TT_Post_Names  names  = &ttface->postscript_names;
 
     FT_UInt  i, max_gid = FT_UINT_MAX;
 
@@ -197,6 +212,18 @@
       FT_TRACE0(( "Ignore glyph names for invalid GID 0x%08x - 0x%08lx\n",
                   FT_UINT_MAX, face->num_glyphs ));
 
+    if ( names->name_hash                                          ||
+         !ft_hash_str_new_names( &names->name_hash, max_gid,
+                                 sfnt_get_glyph_ps_name, ttface,
+                                 face->memory )                    )
+    {
+      size_t*  gid = ft_hash_str_lookup( glyph_name, names->name_hash );
+
+
+      return gid ? (FT_UInt)*gid : 0;
+    }
+
+    /* out of memory; fall back to a linear search */
     for ( i = 0; i < max_gid; i++ )
     {
       FT_String*  gname;
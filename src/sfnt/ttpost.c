@@ -426,6 +426,13 @@
     FT_Fixed       format;
 
 
+    /* the hash keys point into the name tables, so free it first */
+    if ( names->name_hash )
+    {
+      ft_hash_str_free( names->name_hash, memory );
+      FT_FREE( names->name_hash );
+    }
+
     if ( names->loaded )
     {
       format = face->postscript.FormatType;
@@ -346,6 +346,13 @@ typedef ptrdiff_t  FT_PtrDist;
 #define DOWNSCALE( x )  ( (x) * ( 64 >> PIXEL_BITS ) )
 #endif
 
+  /* Outlines with overlapping contours are rendered with each pixel */
+  /* split into SUBPIXELS x SUBPIXELS subpixels.  The fill rule is   */
+  /* applied to the exact coverage of each subpixel, and the         */
+  /* subpixels of a pixel row are summed up during the sweep.        */
+#define SUBPIXEL_BITS  2
+#define SUBPIXELS      ( 1 << SUBPIXEL_BITS )
+
 
   /* Compute `dividend / divisor' and return both its quotient and     */
   /* remainder, cast to a specific type.  This macro also ensures that */
@@ -421,6 +428,7 @@ typedef ptrdiff_t  FT_PtrDist;
   {
     unsigned char*  origin;  /* pixmap origin at the bottom-left */
     int             pitch;   /* pitch to go down one row */
+    int             step;    /* distance between adjacent pixels */
 
   } TPixmap;
 
@@ -431,6 +439,12 @@ typedef ptrdiff_t  FT_PtrDist;
 #define FT_MAX_GRAY_POOL  ( 2048 / sizeof ( TCell ) )
 #endif
 
+  /* LCD channels and overlap subpixels need more cells in each band */
+#define FT_MAX_GRAY_BIG_POOL  ( 4 * (FT_PtrDist)FT_MAX_GRAY_POOL )
+
+  /* the heap pool grows up to this size for very wide outlines */
+#define FT_MAX_GRAY_HUGE_POOL  ( 64 * (FT_PtrDist)FT_MAX_GRAY_POOL )
+
   /* FT_Span buffer size for direct rendering only */
 #define FT_MAX_GRAY_SPANS  10
 
@@ -461,10 +475,21 @@ typedef ptrdiff_t  FT_PtrDist;
     FT_PtrDist  num_cells;
 
     TPos    x,  y;
+    TPos    dx, dy;    /* outline offset of the current LCD channel */
 
     FT_Outline  outline;
     TPixmap     target;
 
+    int         num_channels;       /* 3 for LCD rendering, 1 otherwise */
+    FT_Vector   channel_offset[3];  /* outline offsets of the channels  */
+    int         channel_delta;      /* byte distance between channels   */
+    int         overlap;            /* resolve overlapping contours     */
+    int         sub_pixels;         /* SUBPIXELS for overlaps, else 1   */
+    PCell       big_pool;           /* heap pool, if any                */
+    FT_PtrDist  big_pool_size;
+
+    struct gray_TRaster_*  raster;  /* owner of the heap pool */
+
     FT_Raster_Span_Func  render_span;
     void*                render_span_data;
     FT_Span              spans[FT_MAX_GRAY_SPANS];
@@ -488,6 +513,11 @@ typedef ptrdiff_t  FT_PtrDist;
   {
     void*         memory;
 
+    unsigned long  lcd_mode;        /* set with `gray_raster_set_mode' */
+    FT_Vector      lcd_offset[3];
+    PCell          big_pool;        /* allocated on first use, if possible */
+    FT_PtrDist     big_pool_size;
+
   } gray_TRaster, *gray_PRaster;
 
 
@@ -718,17 +748,26 @@ typedef ptrdiff_t  FT_PtrDist;
          ( ey1 <  ras.min_ey && ey2 <  ras.min_ey ) )
       goto End;
 
+    /* perform horizontal clipping */
+    if ( TRUNC( ras.x ) >= ras.max_ex && TRUNC( to_x ) >= ras.max_ex )
+      goto End;
+
+    /* left of the clip box, only the cover matters: keep a vertical line */
+    x2 = to_x;
+    if ( TRUNC( ras.x ) < ras.min_ex && TRUNC( to_x ) < ras.min_ex )
+      x2 = ras.x;
+
     fy1 = FRACT( ras.y );
     fy2 = FRACT( to_y );
 
     /* everything is on a single scanline */
     if ( ey1 == ey2 )
     {
-      gray_render_scanline( RAS_VAR_ ey1, ras.x, fy1, to_x, fy2 );
+      gray_render_scanline( RAS_VAR_ ey1, ras.x, fy1, x2, fy2 );
       goto End;
     }
 
-    dx = to_x - ras.x;
+    dx = x2 - ras.x;
     dy = to_y - ras.y;
 
     /* vertical line - avoid calling gray_render_scanline */
@@ -864,12 +903,23 @@ typedef ptrdiff_t  FT_PtrDist;
     ex1 = TRUNC( ras.x );
     ex2 = TRUNC( to_x );
 
+    /* perform horizontal clipping */
+    if ( ex1 >= ras.max_ex && ex2 >= ras.max_ex )
+      goto End;
+
     fx1 = FRACT( ras.x );
     fy1 = FRACT( ras.y );
 
     dx = to_x - ras.x;
     dy = to_y - ras.y;
 
+    /* left of the clip box, only the cover matters: keep a vertical line */
+    if ( ex1 < ras.min_ex && ex2 < ras.min_ex )
+    {
+      ex2 = ex1;
+      dx  = 0;
+    }
+
     if ( ex1 == ex2 && ey1 == ey2 )       /* inside one cell */
       ;
     else if ( dy == 0 ) /* ex1 != ex2 */  /* any horizontal line */
@@ -978,6 +1028,42 @@ typedef ptrdiff_t  FT_PtrDist;
 
 #endif
 
+  /* An arc whose points all lie above, below, or right of the current */
+  /* band is invisible; left of it, only its cover matters.  In either  */
+  /* case, the arc can be drawn as its chord without changing the       */
+  /* result.                                                            */
+  static int
+  gray_arc_is_clipped( RAS_ARG_ const FT_Vector*  arc,
+                                int               n )
+  {
+    TPos  min_x = arc[0].x;
+    TPos  max_x = arc[0].x;
+    TPos  min_y = arc[0].y;
+    TPos  max_y = arc[0].y;
+
+
+    while ( --n > 0 )
+    {
+      arc++;
+
+      if ( arc->x < min_x )
+        min_x = arc->x;
+      else if ( arc->x > max_x )
+        max_x = arc->x;
+
+      if ( arc->y < min_y )
+        min_y = arc->y;
+      else if ( arc->y > max_y )
+        max_y = arc->y;
+    }
+
+    return TRUNC( max_y ) <  ras.min_ey ||
+           TRUNC( min_y ) >= ras.max_ey ||
+           TRUNC( min_x ) >= ras.max_ex ||
+           TRUNC( max_x ) <  ras.min_ex;
+  }
+
+
   static void
   gray_split_conic( FT_Vector*  base )
   {
@@ -1010,23 +1096,17 @@ typedef ptrdiff_t  FT_PtrDist;
     int         draw, split;
 
 
-    arc[0].x = UPSCALE( to->x );
-    arc[0].y = UPSCALE( to->y );
-    arc[1].x = UPSCALE( control->x );
-    arc[1].y = UPSCALE( control->y );
+    arc[0].x = UPSCALE( to->x + ras.dx );
+    arc[0].y = UPSCALE( to->y + ras.dy );
+    arc[1].x = UPSCALE( control->x + ras.dx );
+    arc[1].y = UPSCALE( control->y + ras.dy );
     arc[2].x = ras.x;
     arc[2].y = ras.y;
 
-    /* short-cut the arc that crosses the current band */
-    if ( ( TRUNC( arc[0].y ) >= ras.max_ey &&
-           TRUNC( arc[1].y ) >= ras.max_ey &&
-           TRUNC( arc[2].y ) >= ras.max_ey ) ||
-         ( TRUNC( arc[0].y ) <  ras.min_ey &&
-           TRUNC( arc[1].y ) <  ras.min_ey &&
-           TRUNC( arc[2].y ) <  ras.min_ey ) )
+    /* short-cut the arc that misses the current band or clip box */
+    if ( gray_arc_is_clipped( RAS_VAR_ arc, 3 ) )
     {
-      ras.x = arc[0].x;
-      ras.y = arc[0].y;
+      gray_render_line( RAS_VAR_ arc[0].x, arc[0].y );
       return;
     }
 
@@ -1051,11 +1131,17 @@ typedef ptrdiff_t  FT_PtrDist;
     do
     {
       split = draw & ( -draw );  /* isolate the rightmost 1-bit */
-      while ( ( split >>= 1 ) )
-      {
-        gray_split_conic( arc );
-        arc += 2;
-      }
+
+      /* the arc on top covers `split' segments; */
+      /* draw it at once if it is clipped        */
+      if ( split > 1 && gray_arc_is_clipped( RAS_VAR_ arc, 3 ) )
+        draw -= split - 1;
+      else
+        while ( ( split >>= 1 ) )
+        {
+          gray_split_conic( arc );
+          arc += 2;
+        }
 
       gray_render_line( RAS_VAR_ arc[0].x, arc[0].y );
       arc -= 2;
@@ -1105,39 +1191,26 @@ typedef ptrdiff_t  FT_PtrDist;
     FT_Vector*  arc = bez_stack;
 
 
-    arc[0].x = UPSCALE( to->x );
-    arc[0].y = UPSCALE( to->y );
-    arc[1].x = UPSCALE( control2->x );
-    arc[1].y = UPSCALE( control2->y );
-    arc[2].x = UPSCALE( control1->x );
-    arc[2].y = UPSCALE( control1->y );
+    arc[0].x = UPSCALE( to->x + ras.dx );
+    arc[0].y = UPSCALE( to->y + ras.dy );
+    arc[1].x = UPSCALE( control2->x + ras.dx );
+    arc[1].y = UPSCALE( control2->y + ras.dy );
+    arc[2].x = UPSCALE( control1->x + ras.dx );
+    arc[2].y = UPSCALE( control1->y + ras.dy );
     arc[3].x = ras.x;
     arc[3].y = ras.y;
 
-    /* short-cut the arc that crosses the current band */
-    if ( ( TRUNC( arc[0].y ) >= ras.max_ey &&
-           TRUNC( arc[1].y ) >= ras.max_ey &&
-           TRUNC( arc[2].y ) >= ras.max_ey &&
-           TRUNC( arc[3].y ) >= ras.max_ey ) ||
-         ( TRUNC( arc[0].y ) <  ras.min_ey &&
-           TRUNC( arc[1].y ) <  ras.min_ey &&
-           TRUNC( arc[2].y ) <  ras.min_ey &&
-           TRUNC( arc[3].y ) <  ras.min_ey ) )
-    {
-      ras.x = arc[0].x;
-      ras.y = arc[0].y;
-      return;
-    }
-
     for (;;)
     {
       /* with each split, control points quickly converge towards  */
       /* chord trisection points and the vanishing distances below */
-      /* indicate when the segment is flat enough to draw          */
-      if ( FT_ABS( 2 * arc[0].x - 3 * arc[1].x + arc[3].x ) > ONE_PIXEL / 2 ||
-           FT_ABS( 2 * arc[0].y - 3 * arc[1].y + arc[3].y ) > ONE_PIXEL / 2 ||
-           FT_ABS( arc[0].x - 3 * arc[2].x + 2 * arc[3].x ) > ONE_PIXEL / 2 ||
-           FT_ABS( arc[0].y - 3 * arc[2].y + 2 * arc[3].y ) > ONE_PIXEL / 2 )
+      /* indicate when the segment is flat enough to draw; arcs    */
+      /* that miss the current band or clip box are never split    */
+      if ( ( FT_ABS( 2 * arc[0].x - 3 * arc[1].x + arc[3].x ) > ONE_PIXEL / 2 ||
+             FT_ABS( 2 * arc[0].y - 3 * arc[1].y + arc[3].y ) > ONE_PIXEL / 2 ||
+             FT_ABS( arc[0].x - 3 * arc[2].x + 2 * arc[3].x ) > ONE_PIXEL / 2 ||
+             FT_ABS( arc[0].y - 3 * arc[2].y + 2 * arc[3].y ) > ONE_PIXEL / 2 ) &&
+           !gray_arc_is_clipped( RAS_VAR_ arc, 4 )                                )
         goto Split;
 
       gray_render_line( RAS_VAR_ arc[0].x, arc[0].y );
@@ -1163,8 +1236,8 @@ typedef ptrdiff_t  FT_PtrDist;
 
 
     /* start to a new position */
-    x = UPSCALE( to->x );
-    y = UPSCALE( to->y );
+    x = UPSCALE( to->x + ras.dx );
+    y = UPSCALE( to->y + ras.dy );
 
     gray_set_cell( RAS_VAR_ TRUNC( x ), TRUNC( y ) );
 
@@ -1178,7 +1251,8 @@ typedef ptrdiff_t  FT_PtrDist;
   gray_line_to( const FT_Vector*  to,
                 gray_PWorker      worker )
   {
-    gray_render_line( RAS_VAR_ UPSCALE( to->x ), UPSCALE( to->y ) );
+    gray_render_line( RAS_VAR_ UPSCALE( to->x + ras.dx ),
+                               UPSCALE( to->y + ras.dy ) );
     return 0;
   }
 
@@ -1205,31 +1279,11 @@ typedef ptrdiff_t  FT_PtrDist;
 
 
   static void
-  gray_hline( RAS_ARG_ TCoord  x,
-                       TCoord  y,
-                       TArea   coverage,
-                       TCoord  acount )
+  gray_fill( RAS_ARG_ TCoord         x,
+                      TCoord         y,
+                      unsigned char  coverage,
+                      TCoord         acount )
   {
-    /* scale the coverage from 0..(ONE_PIXEL*ONE_PIXEL*2) to 0..256  */
-    coverage >>= PIXEL_BITS * 2 + 1 - 8;
-
-    /* compute the line's coverage depending on the outline fill rule */
-    if ( ras.outline.flags & FT_OUTLINE_EVEN_ODD_FILL )
-    {
-      coverage &= 511;
-
-      if ( coverage >= 256 )
-        coverage = 511 - coverage;
-    }
-    else  /* default non-zero winding rule */
-    {
-      if ( coverage < 0 )
-        coverage = ~coverage;  /* the same as -coverage - 1 */
-
-      if ( coverage >= 256 )
-        coverage = 255;
-    }
-
     if ( ras.num_spans >= 0 )  /* for FT_RASTER_FLAG_DIRECT only */
     {
       FT_Span*  span = ras.spans + ras.num_spans++;
@@ -1237,7 +1291,7 @@ typedef ptrdiff_t  FT_PtrDist;
 
       span->x        = (short)x;
       span->len      = (unsigned short)acount;
-      span->coverage = (unsigned char)coverage;
+      span->coverage = coverage;
 
       if ( ras.num_spans == FT_MAX_GRAY_SPANS )
       {
@@ -1246,10 +1300,20 @@ typedef ptrdiff_t  FT_PtrDist;
         ras.num_spans = 0;
       }
     }
+    else if ( ras.target.step > 1 )  /* for horizontal LCD channels only */
+    {
+      unsigned char*  q = ras.target.origin - ras.target.pitch * y +
+                            x * ras.target.step;
+      unsigned char   c = coverage;
+
+
+      for ( ; acount > 0; acount--, q += ras.target.step )
+        *q = c;
+    }
     else
     {
       unsigned char*  q = ras.target.origin - ras.target.pitch * y + x;
-      unsigned char   c = (unsigned char)coverage;
+      unsigned char   c = coverage;
 
 
       /* For small-spans it is faster to do it by ourselves than
@@ -1289,35 +1353,216 @@ typedef ptrdiff_t  FT_PtrDist;
 
 
   static void
-  gray_sweep( RAS_ARG )
+  gray_hline( RAS_ARG_ TCoord  x,
+                       TCoord  y,
+                       TArea   coverage,
+                       TCoord  acount )
   {
-    int  y;
+    /* scale the coverage from 0..(ONE_PIXEL*ONE_PIXEL*2) to 0..256  */
+    coverage >>= PIXEL_BITS * 2 + 1 - 8;
 
+    /* compute the line's coverage depending on the outline fill rule */
+    if ( ras.outline.flags & FT_OUTLINE_EVEN_ODD_FILL )
+    {
+      coverage &= 511;
 
-    for ( y = ras.min_ey; y < ras.max_ey; y++ )
+      if ( coverage >= 256 )
+        coverage = 511 - coverage;
+    }
+    else  /* default non-zero winding rule */
     {
-      PCell   cell  = ras.ycells[y - ras.min_ey];
-      TCoord  x     = ras.min_ex;
-      TArea   cover = 0;
-      TArea   area;
+      if ( coverage < 0 )
+        coverage = ~coverage;  /* the same as -coverage - 1 */
+
+      if ( coverage >= 256 )
+        coverage = 255;
+    }
 
+    gray_fill( RAS_VAR_ x, y, (unsigned char)coverage, acount );
+  }
 
-      for ( ; cell != NULL; cell = cell->next )
+
+  /* resolve the fill rule for the exact coverage of one subpixel */
+  static TArea
+  gray_subpixel_coverage( RAS_ARG_ TArea  coverage )
+  {
+    if ( ras.outline.flags & FT_OUTLINE_EVEN_ODD_FILL )
+    {
+      coverage &= ONE_PIXEL * ONE_PIXEL * 4 - 1;
+
+      if ( coverage > ONE_PIXEL * ONE_PIXEL * 2 )
+        coverage = ONE_PIXEL * ONE_PIXEL * 4 - coverage;
+    }
+    else  /* default non-zero winding rule */
+    {
+      if ( coverage < 0 )
+        coverage = -coverage;
+
+      if ( coverage > ONE_PIXEL * ONE_PIXEL * 2 )
+        coverage = ONE_PIXEL * ONE_PIXEL * 2;
+    }
+
+    return coverage;
+  }
+
+
+  /* scale the sum of subpixel coverages to 0..255 and draw it */
+  static void
+  gray_subpixel_hline( RAS_ARG_ TCoord  x,
+                                TCoord  y,
+                                TArea   coverage,
+                                TCoord  acount )
+  {
+    coverage >>= PIXEL_BITS * 2 + 1 - 8 + 2 * SUBPIXEL_BITS;
+
+    if ( coverage >= 256 )
+      coverage = 255;
+
+    gray_fill( RAS_VAR_ x, y, (unsigned char)coverage, acount );
+  }
+
+
+  /* Sweep the subrows of a pixel row together, merging their cell   */
+  /* lists in order; each subrow keeps its own cover.  A cell covers */
+  /* a single subpixel, and cells are grouped by the pixel they fall */
+  /* in.                                                             */
+  static void
+  gray_sweep_subrows( RAS_ARG_ PCell*  ycells,
+                               TCoord  y )
+  {
+    PCell   cells[SUBPIXELS];
+    TArea   covers[SUBPIXELS];
+    TCoord  min_x = ras.min_ex >> SUBPIXEL_BITS;
+    TCoord  max_x = ras.max_ex >> SUBPIXEL_BITS;
+    TCoord  x     = min_x;
+    int     s;
+
+
+    for ( s = 0; s < SUBPIXELS; s++ )
+    {
+      cells[s]  = ycells[s];
+      covers[s] = 0;
+    }
+
+    for (;;)
+    {
+      /* recorded cells are always left of `max_ex' */
+      TCoord  cx  = max_x;
+      TArea   sum = 0;
+
+
+      for ( s = 0; s < SUBPIXELS; s++ )
+        if ( cells[s] && ( cells[s]->x >> SUBPIXEL_BITS ) < cx )
+          cx = cells[s]->x >> SUBPIXEL_BITS;
+
+      if ( cx > x )
+      {
+        for ( s = 0; s < SUBPIXELS; s++ )
+          if ( covers[s] )
+            sum += gray_subpixel_coverage( RAS_VAR_ covers[s] );
+
+        if ( sum )
+          gray_subpixel_hline( RAS_VAR_ x, y, sum << SUBPIXEL_BITS, cx - x );
+
+        sum = 0;
+      }
+
+      if ( cx == max_x )
+        break;
+
+      /* add up the subpixels of pixel `cx' */
+      for ( s = 0; s < SUBPIXELS; s++ )
       {
-        if ( cover != 0 && cell->x > x )
-          gray_hline( RAS_VAR_ x, y, cover, cell->x - x );
+        PCell   cell  = cells[s];
+        TArea   cover = covers[s];
+        TCoord  sx    = cx * SUBPIXELS;
+        TCoord  ex    = sx + SUBPIXELS;
+
+
+        for ( ; cell && cell->x < ex; cell = cell->next )
+        {
+          TArea  area;
+
 
-        cover += (TArea)cell->cover * ( ONE_PIXEL * 2 );
-        area   = cover - cell->area;
+          /* subpixels between cells */
+          if ( cover && cell->x > sx )
+            sum += gray_subpixel_coverage( RAS_VAR_ cover ) * ( cell->x - sx );
 
-        if ( area != 0 && cell->x >= ras.min_ex )
-          gray_hline( RAS_VAR_ cell->x, y, area, 1 );
+          cover += (TArea)cell->cover * ( ONE_PIXEL * 2 );
+          area   = cover - cell->area;
 
-        x = cell->x + 1;
+          if ( area )
+            sum += gray_subpixel_coverage( RAS_VAR_ area );
+
+          sx = cell->x + 1;
+        }
+
+        if ( cover && ex > sx )
+          sum += gray_subpixel_coverage( RAS_VAR_ cover ) * ( ex - sx );
+
+        cells[s]  = cell;
+        covers[s] = cover;
       }
 
-      if ( cover != 0 )
-        gray_hline( RAS_VAR_ x, y, cover, ras.max_ex - x );
+      /* the cells left of the clip box only carry cover */
+      if ( sum && cx >= min_x )
+        gray_subpixel_hline( RAS_VAR_ cx, y, sum, 1 );
+
+      x = cx + 1;
+    }
+  }
+
+
+  static void
+  gray_sweep( RAS_ARG )
+  {
+    unsigned char*  origin = ras.target.origin;
+    TCoord          height = ras.max_ey - ras.min_ey;
+    TCoord          min_y  = ras.min_ey / ras.sub_pixels;
+    TCoord          max_y  = ras.max_ey / ras.sub_pixels;
+    int             y, c;
+
+
+    for ( y = min_y; y < max_y; y++ )
+    {
+      /* in LCD mode, the cells of each channel are kept in separate */
+      /* lists, one band height apart, and swept into interleaved    */
+      /* target bytes; otherwise there is a single channel           */
+      for ( c = 0; c < ras.num_channels; c++ )
+      {
+        PCell*  ycells = ras.ycells + ( y - min_y ) * ras.sub_pixels +
+                                      c * height;
+        PCell   cell   = *ycells;
+        TCoord  x      = ras.min_ex;
+        TArea   cover  = 0;
+        TArea   area;
+
+
+        ras.target.origin = origin + c * ras.channel_delta;
+
+        if ( ras.overlap )
+        {
+          gray_sweep_subrows( RAS_VAR_ ycells, y );
+          continue;
+        }
+
+        for ( ; cell != NULL; cell = cell->next )
+        {
+          if ( cover != 0 && cell->x > x )
+            gray_hline( RAS_VAR_ x, y, cover, cell->x - x );
+
+          cover += (TArea)cell->cover * ( ONE_PIXEL * 2 );
+          area   = cover - cell->area;
+
+          if ( area != 0 && cell->x >= ras.min_ex )
+            gray_hline( RAS_VAR_ cell->x, y, area, 1 );
+
+          x = cell->x + 1;
+        }
+
+        if ( cover != 0 )
+          gray_hline( RAS_VAR_ x, y, cover, ras.max_ex - x );
+      }
 
       if ( ras.num_spans > 0 )  /* for FT_RASTER_FLAG_DIRECT only */
       {
@@ -1326,6 +1571,8 @@ typedef ptrdiff_t  FT_PtrDist;
         ras.num_spans = 0;
       }
     }
+
+    ras.target.origin = origin;
   }
 
 
@@ -1629,25 +1876,71 @@ typedef ptrdiff_t  FT_PtrDist;
     0                                        /* delta    */
   )
 
+  /* with overlaps, the outline is decomposed at subpixel resolution */
+  FT_DEFINE_OUTLINE_FUNCS(
+    overlap_interface,
+
+    (FT_Outline_MoveTo_Func) gray_move_to,   /* move_to  */
+    (FT_Outline_LineTo_Func) gray_line_to,   /* line_to  */
+    (FT_Outline_ConicTo_Func)gray_conic_to,  /* conic_to */
+    (FT_Outline_CubicTo_Func)gray_cubic_to,  /* cubic_to */
+
+    SUBPIXEL_BITS,                           /* shift    */
+    0                                        /* delta    */
+  )
+
 
+  /* Decompose the outline once per channel, shifted by the channel */
+  /* offset, into the channel's own cell lists; all channels share   */
+  /* the cell pool and are swept in one pass.                        */
   static int
-  gray_convert_glyph_inner( RAS_ARG,
-                            int  continued )
+  gray_convert_channels( RAS_ARG_ PCell*  ycells,
+                                  int     continued )
   {
-    int  error;
+    TCoord  height = ras.max_ey - ras.min_ey;
+    int     error  = 0;
+    int     c;
 
 
-    if ( ft_setjmp( ras.jump_buffer ) == 0 )
+    for ( c = 0; c < ras.num_channels && !error; c++ )
     {
+      ras.ycells  = ycells + c * height;
+      ras.dx      = ras.channel_offset[c].x * ras.sub_pixels;
+      ras.dy      = ras.channel_offset[c].y * ras.sub_pixels;
+      ras.invalid = 1;
+
       if ( continued )
         FT_Trace_Disable();
-      error = FT_Outline_Decompose( &ras.outline, &func_interface, &ras );
+      error = FT_Outline_Decompose( &ras.outline,
+                                    ras.overlap ? &overlap_interface
+                                                : &func_interface,
+                                    &ras );
       if ( continued )
         FT_Trace_Enable();
 
       if ( !ras.invalid )
         gray_record_cell( RAS_VAR );
 
+      continued = 1;
+    }
+
+    return error;
+  }
+
+
+  static int
+  gray_convert_glyph_inner( RAS_ARG,
+                            int  continued )
+  {
+    PCell*  ycells = ras.ycells;
+    int     error;
+
+
+    if ( ft_setjmp( ras.jump_buffer ) == 0 )
+    {
+      error      = gray_convert_channels( RAS_VAR_ ycells, continued );
+      ras.ycells = ycells;
+
       FT_TRACE7(( "band [%d..%d]: %ld cell%s\n",
                   ras.min_ey,
                   ras.max_ey,
@@ -1658,6 +1951,8 @@ typedef ptrdiff_t  FT_PtrDist;
     {
       error = FT_THROW( Memory_Overflow );
 
+      ras.ycells = ycells;
+
       FT_TRACE7(( "band [%d..%d]: to be bisected\n",
                   ras.min_ey, ras.max_ey ));
     }
@@ -1666,6 +1961,32 @@ typedef ptrdiff_t  FT_PtrDist;
   }
 
 
+#ifndef STANDALONE_
+
+  /* Make the heap pool of the raster hold at least `size' cells.  The */
+  /* pool is kept for later calls; its contents are not preserved.     */
+  static int
+  gray_grow_pool( gray_PRaster  rast,
+                  FT_PtrDist    size )
+  {
+    FT_Memory  memory = (FT_Memory)rast->memory;
+    FT_Error   error;
+
+
+    if ( rast->big_pool_size >= size )
+      return 1;
+
+    /* keeps the old pool on failure */
+    if ( FT_QRENEW_ARRAY( rast->big_pool, rast->big_pool_size, size ) )
+      return 0;
+
+    rast->big_pool_size = size;
+    return 1;
+  }
+
+#endif /* !STANDALONE_ */
+
+
   static int
   gray_convert_glyph( RAS_ARG )
   {
@@ -1673,15 +1994,32 @@ typedef ptrdiff_t  FT_PtrDist;
     const TCoord  yMax = ras.max_ey;
 
     TCell    buffer[FT_MAX_GRAY_POOL];
-    size_t   height = (size_t)( yMax - yMin );
-    size_t   n = FT_MAX_GRAY_POOL / 8;
-    TCoord   y;
+    PCell    pool      = buffer;
+    size_t   pool_size = FT_MAX_GRAY_POOL;
+    size_t   height;
+    size_t   n;
+    TCoord   y         = yMin;
+    TCoord   y_end;
     TCoord   bands[32];  /* enough to accommodate bisections */
     TCoord*  band;
 
     int  continued = 0;
 
 
+  Layout:
+    /* use the larger pool for LCD channels, subrows, */
+    /* or wide outlines if available                  */
+    if ( ras.big_pool )
+    {
+      pool      = ras.big_pool;
+      pool_size = (size_t)ras.big_pool_size;
+    }
+
+    height = (size_t)( yMax - y );
+
+    /* each channel and subrow of a band needs its own cell lists */
+    n = pool_size / 8 / (size_t)( ras.num_channels * ras.sub_pixels );
+
     /* set up vertical bands */
     if ( height > n )
     {
@@ -1691,21 +2029,22 @@ typedef ptrdiff_t  FT_PtrDist;
     }
 
     /* memory management */
-    n = ( height * sizeof ( PCell ) + sizeof ( TCell ) - 1 ) / sizeof ( TCell );
+    n = ( (size_t)( ras.num_channels * ras.sub_pixels ) * height *
+            sizeof ( PCell ) + sizeof ( TCell ) - 1 ) / sizeof ( TCell );
 
-    ras.cells     = buffer + n;
-    ras.max_cells = (FT_PtrDist)( FT_MAX_GRAY_POOL - n );
-    ras.ycells    = (PCell*)buffer;
+    ras.cells     = pool + n;
+    ras.max_cells = (FT_PtrDist)( pool_size - n );
+    ras.ycells    = (PCell*)pool;
 
-    for ( y = yMin; y < yMax; )
+    for ( ; y < yMax; y = y_end )
     {
-      ras.min_ey = y;
-      y         += height;
-      ras.max_ey = FT_MIN( y, yMax );
+      y_end = y + (TCoord)height;
+      if ( y_end > yMax )
+        y_end = yMax;
 
       band    = bands;
-      band[1] = ras.min_ey;
-      band[0] = ras.max_ey;
+      band[1] = y;
+      band[0] = y_end;
 
       do
       {
@@ -1713,12 +2052,14 @@ typedef ptrdiff_t  FT_PtrDist;
         int     error;
 
 
-        FT_MEM_ZERO( ras.ycells, height * sizeof ( PCell ) );
+        FT_MEM_ZERO( ras.ycells,
+                     (size_t)( ras.num_channels * ras.sub_pixels ) * height *
+                       sizeof ( PCell ) );
 
         ras.num_cells = 0;
         ras.invalid   = 1;
-        ras.min_ey    = band[1];
-        ras.max_ey    = band[0];
+        ras.min_ey    = band[1] * ras.sub_pixels;
+        ras.max_ey    = band[0] * ras.sub_pixels;
 
         error     = gray_convert_glyph_inner( RAS_VAR, continued );
         continued = 1;
@@ -1732,6 +2073,31 @@ typedef ptrdiff_t  FT_PtrDist;
         else if ( error != ErrRaster_Memory_Overflow )
           return 1;
 
+#ifndef STANDALONE_
+        /* Rather than bisecting, get a larger pool and continue with */
+        /* taller bands from here; all rows below are done already.   */
+        if ( ras.raster && ras.big_pool_size < FT_MAX_GRAY_HUGE_POOL )
+        {
+          gray_PRaster  rast = ras.raster;
+          FT_PtrDist    size = ras.big_pool_size < FT_MAX_GRAY_BIG_POOL
+                                 ? FT_MAX_GRAY_BIG_POOL
+                                 : 4 * ras.big_pool_size;
+
+
+          if ( size > FT_MAX_GRAY_HUGE_POOL )
+            size = FT_MAX_GRAY_HUGE_POOL;
+
+          if ( gray_grow_pool( rast, size ) )
+          {
+            ras.big_pool      = rast->big_pool;
+            ras.big_pool_size = rast->big_pool_size;
+
+            y = band[1];
+            goto Layout;
+          }
+        }
+#endif
+
         /* render pool overflow; we will reduce the render band by half */
         width >>= 1;
 
@@ -1758,6 +2124,7 @@ typedef ptrdiff_t  FT_PtrDist;
   {
     const FT_Outline*  outline    = (const FT_Outline*)params->source;
     const FT_Bitmap*   target_map = params->target;
+    gray_PRaster       rast       = (gray_PRaster)raster;
 
 #ifndef FT_STATIC_RASTER
     gray_TWorker  worker[1];
@@ -1787,6 +2154,19 @@ typedef ptrdiff_t  FT_PtrDist;
 
     ras.outline = *outline;
 
+    ras.num_channels        = 1;
+    ras.channel_offset[0].x = 0;
+    ras.channel_offset[0].y = 0;
+    ras.channel_delta       = 0;
+    ras.target.step         = 1;
+    ras.big_pool            = NULL;
+    ras.big_pool_size       = 0;
+    ras.raster              = rast;
+
+    /* resolve overlapping contours on subpixels */
+    ras.overlap    = ( outline->flags & FT_OUTLINE_OVERLAP ) != 0;
+    ras.sub_pixels = ras.overlap ? SUBPIXELS : 1;
+
     if ( params->flags & FT_RASTER_FLAG_DIRECT )
     {
       if ( !params->gray_spans )
@@ -1830,12 +2210,58 @@ typedef ptrdiff_t  FT_PtrDist;
       ras.min_ey = 0;
       ras.max_ex = (FT_Pos)target_map->width;
       ras.max_ey = (FT_Pos)target_map->rows;
+
+      /* render all three channels of an LCD bitmap in a single pass */
+      if ( rast->lcd_mode == FT_GRAYS_MODE_LCD )
+      {
+        ras.num_channels  = 3;
+        ras.channel_delta = 1;
+        ras.target.step   = 3;
+
+        ras.max_ex /= 3;
+      }
+      else if ( rast->lcd_mode == FT_GRAYS_MODE_LCD_V )
+      {
+        ras.num_channels  = 3;
+        ras.channel_delta = target_map->pitch;
+
+        /* the channels of a pixel are on three consecutive rows */
+        ras.max_ey /= 3;
+
+        if ( target_map->pitch >= 0 )
+          ras.target.origin = target_map->buffer +
+                                ( ras.max_ey - 1 ) * 3 *
+                                  (unsigned int)target_map->pitch;
+        ras.target.pitch = 3 * target_map->pitch;
+      }
+
+      if ( ras.num_channels == 3 )
+      {
+        ras.channel_offset[0] = rast->lcd_offset[0];
+        ras.channel_offset[1] = rast->lcd_offset[1];
+        ras.channel_offset[2] = rast->lcd_offset[2];
+      }
     }
 
     /* exit if nothing to do */
     if ( ras.max_ex <= ras.min_ex || ras.max_ey <= ras.min_ey )
       return 0;
 
+    /* with overlaps, cells are subpixels; bands scale their rows */
+    ras.min_ex *= ras.sub_pixels;
+    ras.max_ex *= ras.sub_pixels;
+
+#ifndef STANDALONE_
+    /* without the larger pool, rendering still works but needs */
+    /* narrower bands                                           */
+    if ( ras.num_channels > 1 || ras.overlap )
+      (void)gray_grow_pool( rast, FT_MAX_GRAY_BIG_POOL );
+#endif
+
+    /* once allocated, the heap pool is used for all outlines */
+    ras.big_pool      = rast->big_pool;
+    ras.big_pool_size = rast->big_pool_size;
+
     return gray_convert_glyph( RAS_VAR );
   }
 
@@ -1892,9 +2318,11 @@ typedef ptrdiff_t  FT_PtrDist;
   static void
   gray_raster_done( FT_Raster  raster )
   {
-    FT_Memory  memory = (FT_Memory)((gray_PRaster)raster)->memory;
+    FT_Memory     memory = (FT_Memory)((gray_PRaster)raster)->memory;
+    gray_PRaster  rast   = (gray_PRaster)raster;
 
 
+    FT_FREE( rast->big_pool );
     FT_FREE( raster );
   }
 
@@ -1917,12 +2345,39 @@ typedef ptrdiff_t  FT_PtrDist;
                         unsigned long  mode,
                         void*          args )
   {
-    FT_UNUSED( raster );
-    FT_UNUSED( mode );
-    FT_UNUSED( args );
+    gray_PRaster  rast = (gray_PRaster)raster;
+
+
+    if ( !rast )
+      return FT_THROW( Invalid_Argument );
+
+    switch ( mode )
+    {
+    case FT_GRAYS_MODE_NORMAL:
+      rast->lcd_mode = mode;
+      break;
 
+    case FT_GRAYS_MODE_LCD:
+    case FT_GRAYS_MODE_LCD_V:
+      {
+        FT_Vector*  offset = (FT_Vector*)args;
+
+
+        if ( !offset )
+          return FT_THROW( Invalid_Argument );
+
+        rast->lcd_mode      = mode;
+        rast->lcd_offset[0] = offset[0];
+        rast->lcd_offset[1] = offset[1];
+        rast->lcd_offset[2] = offset[2];
+      }
+      break;
+
+    default:
+      break;  /* ignore unknown modes */
+    }
 
-    return 0; /* nothing to do */
+    return 0;
   }
 
 
@@ -47,6 +47,25 @@
   FT_EXPORT_VAR( const FT_Raster_Funcs )  ft_grays_raster;
 
 
+  /**************************************************************************
+   *
+   * Modes understood by the `raster_set_mode' function of
+   * `ft_grays_raster'.  In the LCD modes, `args' points to an array of
+   * three @FT_Vector offsets that are added to the outline before
+   * rendering the respective color channel; the target bitmap then
+   * receives all three channels in a single pass, either interleaved
+   * horizontally or on consecutive rows.  `FT_GRAYS_MODE_NORMAL' resets
+   * the raster to plain gray-level rendering.
+   */
+  typedef enum  FT_Grays_Mode_
+  {
+    FT_IMAGE_TAG( FT_GRAYS_MODE_NORMAL, 'n', 'o', 'r', 'm' ),
+    FT_IMAGE_TAG( FT_GRAYS_MODE_LCD,    'l', 'c', 'd', 'h' ),
+    FT_IMAGE_TAG( FT_GRAYS_MODE_LCD_V,  'l', 'c', 'd', 'v' )
+
+  } FT_Grays_Mode;
+
+
 #ifdef __cplusplus
   }
 #endif
@@ -76,13 +76,6 @@
       FT_Outline_Get_CBox( &slot->outline, cbox );
   }
 
-  typedef struct TOrigin_
-  {
-    unsigned char*  origin;  /* pixmap origin at the bottom-left */
-    int             pitch;   /* pitch to go down one row */
-
-  } TOrigin;
-
 #ifndef FT_CONFIG_OPTION_SUBPIXEL_RENDERING
 
   /* initialize renderer -- init its raster */
@@ -106,151 +99,80 @@
   }
 
 
-  /* This function writes every third byte in direct rendering mode */
-  static void
-  ft_smooth_lcd_spans( int             y,
-                       int             count,
-                       const FT_Span*  spans,
-                       TOrigin*        target )
-  {
-    unsigned char*  dst_line = target->origin - y * target->pitch;
-    unsigned char*  dst;
-    unsigned short  w;
-
-
-    for ( ; count--; spans++ )
-      for ( dst = dst_line + spans->x * 3, w = spans->len; w--; dst += 3 )
-        *dst = spans->coverage;
-  }
-
-
+  /* Render 3 coverage channels in a single pass of the raster,   */
+  /* shifting the outline by the subpixel geometry for each one.   */
   static FT_Error
-  ft_smooth_raster_lcd( FT_Renderer  render,
-                        FT_Outline*  outline,
-                        FT_Bitmap*   bitmap )
+  ft_smooth_raster_lcd_channels( FT_Renderer    render,
+                                 FT_Outline*    outline,
+                                 FT_Bitmap*     bitmap,
+                                 FT_Grays_Mode  mode,
+                                 FT_Vector*     offset )
   {
-    FT_Error      error = FT_Err_Ok;
-    FT_Vector*    sub   = render->root.library->lcd_geometry;
-    FT_Pos        x, y;
+    FT_Raster_Set_Mode_Func  set_mode =
+                               render->clazz->raster_class->raster_set_mode;
 
-    FT_Raster_Params   params;
-    TOrigin            target;
-
-
-    /* Render 3 separate coverage bitmaps, shifting the outline.  */
-    /* Set up direct rendering to record them on each third byte. */
-    params.target     = bitmap;
-    params.source     = outline;
-    params.flags      = FT_RASTER_FLAG_AA | FT_RASTER_FLAG_DIRECT;
-    params.gray_spans = (FT_SpanFunc)ft_smooth_lcd_spans;
-    params.user       = &target;
-
-    params.clip_box.xMin = 0;
-    params.clip_box.yMin = 0;
-    params.clip_box.xMax = bitmap->width;
-    params.clip_box.yMax = bitmap->rows;
-
-    if ( bitmap->pitch < 0 )
-      target.origin = bitmap->buffer;
-    else
-      target.origin = bitmap->buffer
-                      + ( bitmap->rows - 1 ) * (unsigned int)bitmap->pitch;
+    FT_Error          error;
+    FT_Raster_Params  params;
 
-    target.pitch = bitmap->pitch;
 
-    FT_Outline_Translate( outline,
-                          -sub[0].x,
-                          -sub[0].y );
-    error = render->raster_render( render->raster, &params );
-    x = sub[0].x;
-    y = sub[0].y;
-    if ( error )
-      goto Exit;
+    params.target = bitmap;
+    params.source = outline;
+    params.flags  = FT_RASTER_FLAG_AA;
 
-    target.origin++;
-    FT_Outline_Translate( outline,
-                          sub[0].x - sub[1].x,
-                          sub[0].y - sub[1].y );
-    error = render->raster_render( render->raster, &params );
-    x = sub[1].x;
-    y = sub[1].y;
+    error = set_mode( render->raster, mode, offset );
     if ( error )
-      goto Exit;
+      return error;
 
-    target.origin++;
-    FT_Outline_Translate( outline,
-                          sub[1].x - sub[2].x,
-                          sub[1].y - sub[2].y );
     error = render->raster_render( render->raster, &params );
-    x = sub[2].x;
-    y = sub[2].y;
 
-  Exit:
-    FT_Outline_Translate( outline, x, y );
+    set_mode( render->raster, FT_GRAYS_MODE_NORMAL, NULL );
 
     return error;
   }
 
 
   static FT_Error
-  ft_smooth_raster_lcdv( FT_Renderer  render,
-                         FT_Outline*  outline,
-                         FT_Bitmap*   bitmap )
+  ft_smooth_raster_lcd( FT_Renderer  render,
+                        FT_Outline*  outline,
+                        FT_Bitmap*   bitmap )
   {
-    FT_Error     error = FT_Err_Ok;
-    int          pitch = bitmap->pitch;
-    FT_Vector*   sub   = render->root.library->lcd_geometry;
-    FT_Pos       x, y;
-
-    FT_Raster_Params  params;
-
+    FT_Vector*  sub = render->root.library->lcd_geometry;
+    FT_Vector   offset[3];
+    int         i;
 
-    params.target = bitmap;
-    params.source = outline;
-    params.flags  = FT_RASTER_FLAG_AA;
 
-    /* Render 3 separate coverage bitmaps, shifting the outline. */
-    /* Notice that the subpixel geometry vectors are rotated.    */
-    /* Triple the pitch to render on each third row.            */
-    bitmap->pitch *= 3;
-    bitmap->rows  /= 3;
+    /* the channels are interleaved on each third byte */
+    for ( i = 0; i < 3; i++ )
+    {
+      offset[i].x = -sub[i].x;
+      offset[i].y = -sub[i].y;
+    }
 
-    FT_Outline_Translate( outline,
-                          -sub[0].y,
-                          sub[0].x );
-    error = render->raster_render( render->raster, &params );
-    x = sub[0].y;
-    y = -sub[0].x;
-    if ( error )
-      goto Exit;
+    return ft_smooth_raster_lcd_channels( render, outline, bitmap,
+                                          FT_GRAYS_MODE_LCD, offset );
+  }
 
-    bitmap->buffer += pitch;
-    FT_Outline_Translate( outline,
-                          sub[0].y - sub[1].y,
-                          sub[1].x - sub[0].x );
-    error = render->raster_render( render->raster, &params );
-    x = sub[1].y;
-    y = -sub[1].x;
-    bitmap->buffer -= pitch;
-    if ( error )
-      goto Exit;
 
-    bitmap->buffer += 2 * pitch;
-    FT_Outline_Translate( outline,
-                          sub[1].y - sub[2].y,
-                          sub[2].x - sub[1].x );
-    error = render->raster_render( render->raster, &params );
-    x = sub[2].y;
-    y = -sub[2].x;
-    bitmap->buffer -= 2 * pitch;
+  static FT_Error
+  ft_smooth_raster_lcdv( FT_Renderer  render,
+                         FT_Outline*  outline,
+                         FT_Bitmap*   bitmap )
+  {
+    FT_Vector*  sub = render->root.library->lcd_geometry;
+    FT_Vector   offset[3];
+    int         i;
 
-  Exit:
-    FT_Outline_Translate( outline, x, y );
 
-    bitmap->pitch /= 3;
-    bitmap->rows  *= 3;
+    /* Notice that the subpixel geometry vectors are rotated; */
+    /* the channels go to three consecutive rows.             */
+    for ( i = 0; i < 3; i++ )
+    {
+      offset[i].x = -sub[i].y;
+      offset[i].y = sub[i].x;
+    }
 
-    return error;
+    return ft_smooth_raster_lcd_channels( render, outline, bitmap,
+                                          FT_GRAYS_MODE_LCD_V, offset );
   }
 
 #else   /* FT_CONFIG_OPTION_SUBPIXEL_RENDERING */
@@ -333,93 +255,6 @@
 
 #endif  /* FT_CONFIG_OPTION_SUBPIXEL_RENDERING */
 
-/* Oversampling scale to be used in rendering overlaps */
-#define SCALE  ( 1 << 2 )
-
-  /* This function averages inflated spans in direct rendering mode */
-  static void
-  ft_smooth_overlap_spans( int             y,
-                           int             count,
-                           const FT_Span*  spans,
-                           TOrigin*        target )
-  {
-    unsigned char*  dst = target->origin - ( y / SCALE ) * target->pitch;
-    unsigned short  x;
-    unsigned int    cover, sum;
-
-
-    /* When accumulating the oversampled spans we need to assure that  */
-    /* fully covered pixels are equal to 255 and do not overflow.      */
-    /* It is important that the SCALE is a power of 2, each subpixel   */
-    /* cover can also reach a power of 2 after rounding, and the total */
-    /* is clamped to 255 when it adds up to 256.                       */
-    for ( ; count--; spans++ )
-    {
-      cover = ( spans->coverage + SCALE * SCALE / 2 ) / ( SCALE * SCALE );
-      for ( x = 0; x < spans->len; x++ )
-      {
-        sum                           = dst[( spans->x + x ) / SCALE] + cover;
-        dst[( spans->x + x ) / SCALE] = (unsigned char)( sum - ( sum >> 8 ) );
-      }
-    }
-  }
-
-
-  static FT_Error
-  ft_smooth_raster_overlap( FT_Renderer  render,
-                            FT_Outline*  outline,
-                            FT_Bitmap*   bitmap )
-  {
-    FT_Error    error      = FT_Err_Ok;
-    FT_Vector*  points     = outline->points;
-    FT_Vector*  points_end = FT_OFFSET( points, outline->n_points );
-    FT_Vector*  vec;
-
-    FT_Raster_Params   params;
-    TOrigin            target;
-
-
-    /* Set up direct rendering to average oversampled spans. */
-    params.target     = bitmap;
-    params.source     = outline;
-    params.flags      = FT_RASTER_FLAG_AA | FT_RASTER_FLAG_DIRECT;
-    params.gray_spans = (FT_SpanFunc)ft_smooth_overlap_spans;
-    params.user       = &target;
-
-    params.clip_box.xMin = 0;
-    params.clip_box.yMin = 0;
-    params.clip_box.xMax = bitmap->width * SCALE;
-    params.clip_box.yMax = bitmap->rows  * SCALE;
-
-    if ( bitmap->pitch < 0 )
-      target.origin = bitmap->buffer;
-    else
-      target.origin = bitmap->buffer
-                      + ( bitmap->rows - 1 ) * (unsigned int)bitmap->pitch;
-
-    target.pitch = bitmap->pitch;
-
-    /* inflate outline */
-    for ( vec = points; vec < points_end; vec++ )
-    {
-      vec->x *= SCALE;
-      vec->y *= SCALE;
-    }
-
-    /* render outline into the bitmap */
-    error = render->raster_render( render->raster, &params );
-
-    /* deflate outline */
-    for ( vec = points; vec < points_end; vec++ )
-    {
-      vec->x /= SCALE;
-      vec->y /= SCALE;
-    }
-
-    return error;
-  }
-
-#undef SCALE
 
   static FT_Error
   ft_smooth_render( FT_Renderer       render,
@@ -494,19 +329,15 @@
     if ( mode == FT_RENDER_MODE_NORMAL ||
          mode == FT_RENDER_MODE_LIGHT  )
     {
-      if ( outline->flags & FT_OUTLINE_OVERLAP )
-        error = ft_smooth_raster_overlap( render, outline, bitmap );
-      else
-      {
-        FT_Raster_Params  params;
+      FT_Raster_Params  params;
 
 
-        params.target = bitmap;
-        params.source = outline;
-        params.flags  = FT_RASTER_FLAG_AA;
+      /* the raster resolves overlapping contours by itself */
+      params.target = bitmap;
+      params.source = outline;
+      params.flags  = FT_RASTER_FLAG_AA;
 
-        error = render->raster_render( render->raster, &params );
-      }
+      error = render->raster_render( render->raster, &params );
     }
     else
     {
@@ -0,0 +1,166 @@
+#include <freetype/freetype.h>
+#include <freetype/ftsizes.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <time.h>    /* for clock() */
+
+/* SunOS 4.1.* does not define CLOCKS_PER_SEC, so include <sys/param.h> */
+/* to get the HZ macro which is the equivalent.                         */
+#if defined(__sun__) && !defined(SVR4) && !defined(__SVR4)
+#include <sys/param.h>
+#define CLOCKS_PER_SEC HZ
+#endif
+
+  static long
+  get_time( void )
+  {
+    return clock() * 10000L / CLOCKS_PER_SEC;
+  }
+
+
+
+
+  /* time opening and closing many faces of the same font file */
+
+#define NUM_FACES  50000L
+
+
+  static FT_Byte*
+  load_file( const char*  filename,
+             long*        alength )
+  {
+    FILE*     file;
+    FT_Byte*  buffer = NULL;
+    long      length;
+
+
+    file = fopen( filename, "rb" );
+    if ( !file )
+      return NULL;
+
+    if ( fseek( file, 0, SEEK_END ) == 0 &&
+         ( length = ftell( file ) ) > 0  &&
+         fseek( file, 0, SEEK_SET ) == 0 )
+    {
+      buffer = (FT_Byte*)malloc( (size_t)length );
+      if ( buffer && fread( buffer, 1, (size_t)length, file ) !=
+                       (size_t)length )
+      {
+        free( buffer );
+        buffer = NULL;
+      }
+      *alength = length;
+    }
+
+    fclose( file );
+
+    return buffer;
+  }
+
+
+  /* `order' 0 closes the faces in creation order, 1 in reverse order, */
+  /* and 2 in a scattered order                                        */
+  static int
+  profile_faces( FT_Library  library,
+                 FT_Byte*    buffer,
+                 long        length,
+                 FT_Face*    faces,
+                 long        num_faces,
+                 int         order )
+  {
+    long  count;
+    long  time0, time1;
+
+
+    time0 = get_time();
+    for ( count = 0; count < num_faces; count++ )
+    {
+      FT_Face  face;
+      FT_Size  size;
+
+
+      /* add a second size, as usual for faces shared by several clients */
+      if ( FT_New_Memory_Face( library, buffer, length, 0, &face ) ||
+           FT_New_Size( face, &size )                              )
+      {
+        printf( "cannot open face #%ld\n", count );
+        return 1;
+      }
+
+      faces[count] = face;
+    }
+    time0 = get_time() - time0;
+
+    time1 = get_time();
+    for ( count = 0; count < num_faces; count++ )
+    {
+      long  n;
+
+
+      if ( order == 0 )
+        n = count;
+      else if ( order == 1 )
+        n = num_faces - 1 - count;
+      else
+        n = ( count * 7919L ) % num_faces;
+
+      FT_Done_Face( faces[n] );
+    }
+    time1 = get_time() - time1;
+
+    printf( "order %d: open = %6.3f close = %6.3f\n",
+            order,
+            (double)time0 / 10000.0,
+            (double)time1 / 10000.0 );
+
+    return 0;
+  }
+
+
+  int  main( int  argc, char**  argv )
+  {
+    FT_Library  library;
+    FT_Byte*    buffer;
+    FT_Face*    faces;
+    long        length = 0;
+    long        num_faces = NUM_FACES;
+    int         order;
+    int         result = 0;
+
+
+    if ( argc < 2 )
+    {
+      printf( "usage: test_faces fontfile [num_faces]\n" );
+      return 1;
+    }
+
+    if ( argc > 2 )
+      num_faces = atol( argv[2] );
+    if ( num_faces <= 0 )
+      num_faces = NUM_FACES;
+
+    buffer = load_file( argv[1], &length );
+    faces  = (FT_Face*)malloc( (size_t)num_faces * sizeof ( FT_Face ) );
+    if ( !buffer || !faces )
+    {
+      printf( "cannot load `%s'\n", argv[1] );
+      return 1;
+    }
+
+    if ( FT_Init_FreeType( &library ) )
+      return 1;
+
+    printf( "%ld faces\n", num_faces );
+    for ( order = 0; order < 3 && !result; order++ )
+      result = profile_faces( library, buffer, length,
+                              faces, num_faces, order );
+
+    FT_Done_FreeType( library );
+
+    free( faces );
+    free( buffer );
+
+    return result;
+  }
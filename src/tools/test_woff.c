@@ -0,0 +1,243 @@
+#include <freetype/freetype.h>
+#include <freetype/ftfntfmt.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+  /* open an SFNT font both as is and wrapped into an (uncompressed) WOFF */
+  /* container, then compare the two faces                                */
+
+
+  static FT_Byte*
+  load_file( const char*  filename,
+             long*        alength )
+  {
+    FILE*     file;
+    FT_Byte*  buffer = NULL;
+    long      length;
+
+
+    file = fopen( filename, "rb" );
+    if ( !file )
+      return NULL;
+
+    if ( fseek( file, 0, SEEK_END ) == 0 &&
+         ( length = ftell( file ) ) > 0  &&
+         fseek( file, 0, SEEK_SET ) == 0 )
+    {
+      buffer = (FT_Byte*)malloc( (size_t)length );
+      if ( buffer && fread( buffer, 1, (size_t)length, file ) !=
+                       (size_t)length )
+      {
+        free( buffer );
+        buffer = NULL;
+      }
+      *alength = length;
+    }
+
+    fclose( file );
+
+    return buffer;
+  }
+
+
+  static unsigned long
+  get_ulong( const FT_Byte*  p )
+  {
+    return ( (unsigned long)p[0] << 24 ) | ( (unsigned long)p[1] << 16 ) |
+           ( (unsigned long)p[2] << 8  ) |   (unsigned long)p[3];
+  }
+
+
+  static void
+  put_ulong( FT_Byte*       p,
+             unsigned long  value )
+  {
+    p[0] = (FT_Byte)( value >> 24 );
+    p[1] = (FT_Byte)( value >> 16 );
+    p[2] = (FT_Byte)( value >> 8 );
+    p[3] = (FT_Byte)value;
+  }
+
+
+#define PAD4( x )  ( ( (x) + 3 ) & ~3UL )
+
+
+  /* store every table uncompressed, which WOFF allows */
+  static FT_Byte*
+  make_woff( const FT_Byte*  sfnt,
+             long            sfnt_length,
+             long*           alength )
+  {
+    FT_Byte*       woff;
+    unsigned long  num_tables, n;
+    unsigned long  offset, sfnt_size, length;
+
+
+    if ( sfnt_length < 12 )
+      return NULL;
+
+    num_tables = ( (unsigned long)sfnt[4] << 8 ) | sfnt[5];
+    if ( (unsigned long)sfnt_length < 12 + 16 * num_tables )
+      return NULL;
+
+    offset    = 44 + 20 * num_tables;
+    sfnt_size = 12 + 16 * num_tables;
+    length    = offset;
+    for ( n = 0; n < num_tables; n++ )
+    {
+      const FT_Byte*  entry      = sfnt + 12 + 16 * n;
+      unsigned long   tab_offset = get_ulong( entry + 8 );
+      unsigned long   tab_length = get_ulong( entry + 12 );
+
+
+      if ( tab_offset > (unsigned long)sfnt_length              ||
+           tab_length > (unsigned long)sfnt_length - tab_offset )
+        return NULL;
+
+      length    += PAD4( tab_length );
+      sfnt_size += PAD4( tab_length );
+    }
+
+    woff = (FT_Byte*)calloc( 1, length );
+    if ( !woff )
+      return NULL;
+
+    memcpy( woff, "wOFF", 4 );
+    memcpy( woff + 4, sfnt, 4 );                  /* flavor         */
+    put_ulong( woff + 8, length );
+    woff[12] = (FT_Byte)( num_tables >> 8 );
+    woff[13] = (FT_Byte)num_tables;
+    put_ulong( woff + 16, sfnt_size );            /* totalSfntSize  */
+    woff[20] = 1;                                 /* majorVersion   */
+
+    for ( n = 0; n < num_tables; n++ )
+    {
+      const FT_Byte*  entry      = sfnt + 12 + 16 * n;
+      FT_Byte*        dir        = woff + 44 + 20 * n;
+      unsigned long   tab_offset = get_ulong( entry + 8 );
+      unsigned long   tab_length = get_ulong( entry + 12 );
+
+
+      memcpy( dir, entry, 4 );                    /* tag            */
+      put_ulong( dir + 4, offset );
+      put_ulong( dir + 8, tab_length );           /* compLength     */
+      put_ulong( dir + 12, tab_length );          /* origLength     */
+      memcpy( dir + 16, entry + 4, 4 );           /* origChecksum   */
+
+      memcpy( woff + offset, sfnt + tab_offset, tab_length );
+      offset += PAD4( tab_length );
+    }
+
+    *alength = (long)length;
+
+    return woff;
+  }
+
+
+  static int
+  compare_faces( FT_Face  sfnt_face,
+                 FT_Face  woff_face )
+  {
+    FT_Long  idx;
+
+
+    if ( sfnt_face->num_glyphs != woff_face->num_glyphs ||
+         strcmp( FT_Get_Font_Format( sfnt_face ),
+                 FT_Get_Font_Format( woff_face ) )     )
+    {
+      printf( "face properties differ\n" );
+      return 1;
+    }
+
+    if ( FT_Set_Char_Size( sfnt_face, 0, 16 * 64, 72, 72 ) ||
+         FT_Set_Char_Size( woff_face, 0, 16 * 64, 72, 72 ) )
+    {
+      printf( "cannot set character size\n" );
+      return 1;
+    }
+
+    for ( idx = 0; idx < sfnt_face->num_glyphs; idx++ )
+    {
+      FT_Outline*  o1;
+      FT_Outline*  o2;
+
+
+      if ( FT_Load_Glyph( sfnt_face, (FT_UInt)idx, FT_LOAD_NO_HINTING ) ||
+           FT_Load_Glyph( woff_face, (FT_UInt)idx, FT_LOAD_NO_HINTING ) )
+      {
+        printf( "cannot load glyph %ld\n", idx );
+        return 1;
+      }
+
+      o1 = &sfnt_face->glyph->outline;
+      o2 = &woff_face->glyph->outline;
+      if ( o1->n_points != o2->n_points                    ||
+           o1->n_contours != o2->n_contours                ||
+           memcmp( o1->points, o2->points,
+                   (size_t)o1->n_points * sizeof ( FT_Vector ) ) )
+      {
+        printf( "outlines of glyph %ld differ\n", idx );
+        return 1;
+      }
+    }
+
+    return 0;
+  }
+
+
+  int  main( int  argc, char**  argv )
+  {
+    FT_Library  library;
+    FT_Face     sfnt_face, woff_face;
+    FT_Byte*    sfnt;
+    FT_Byte*    woff = NULL;
+    long        sfnt_length = 0;
+    long        woff_length = 0;
+    int         result;
+
+
+    if ( argc < 2 )
+    {
+      printf( "usage: test_woff fontfile\n" );
+      return 1;
+    }
+
+    sfnt = load_file( argv[1], &sfnt_length );
+    if ( sfnt )
+      woff = make_woff( sfnt, sfnt_length, &woff_length );
+    if ( !woff )
+    {
+      printf( "cannot load `%s' as an SFNT font\n", argv[1] );
+      return 1;
+    }
+
+    if ( FT_Init_FreeType( &library ) )
+      return 1;
+
+    if ( FT_New_Memory_Face( library, sfnt, sfnt_length, 0, &sfnt_face ) )
+    {
+      printf( "cannot open `%s'\n", argv[1] );
+      return 1;
+    }
+
+    if ( FT_New_Memory_Face( library, woff, woff_length, 0, &woff_face ) )
+    {
+      printf( "cannot open WOFF version of `%s'\n", argv[1] );
+      return 1;
+    }
+
+    result = compare_faces( sfnt_face, woff_face );
+    if ( !result )
+      printf( "%s: %ld glyphs, WOFF and SFNT faces are identical\n",
+              FT_Get_Font_Format( woff_face ), woff_face->num_glyphs );
+
+    FT_Done_FreeType( library );
+
+    free( woff );
+    free( sfnt );
+
+    return result;
+  }
@@ -30,6 +30,7 @@
 #include <freetype/internal/services/svtteng.h>
 #include <freetype/internal/services/svttglyf.h>
 #include <freetype/internal/services/svprop.h>
+#include <freetype/internal/services/svpurge.h>
 #include <freetype/ftdriver.h>
 
 #include "ttdriver.h"
@@ -228,18 +229,37 @@
     FT_UInt  nn;
     TT_Face  face = (TT_Face)ttface;
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    TT_Size   size   = (TT_Size)ttface->size;
+    FT_Bool   varied = FT_BOOL( FT_IS_NAMED_INSTANCE( ttface ) ||
+                                FT_IS_VARIATION( ttface )      ||
+                                ( size && size->var_coords )   );
+    FT_Error  error;
+#endif
+
 
     /* XXX: TODO: check for sbits */
 
-    if ( flags & FT_LOAD_VERTICAL_LAYOUT )
-    {
 #ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
-      /* no fast retrieval for blended MM fonts without VVAR table */
-      if ( ( FT_IS_NAMED_INSTANCE( ttface ) || FT_IS_VARIATION( ttface ) ) &&
-           !( face->variation_support & TT_FACE_FLAG_VAR_VADVANCE )        )
-        return FT_THROW( Unimplemented_Feature );
+    /* no fast retrieval for blended MM fonts without VVAR or HVAR table */
+    if ( varied                                                       &&
+         !( face->variation_support &
+            ( ( flags & FT_LOAD_VERTICAL_LAYOUT )
+                ? TT_FACE_FLAG_VAR_VADVANCE
+                : TT_FACE_FLAG_VAR_HADVANCE ) )                       )
+      return FT_THROW( Unimplemented_Feature );
+
+    /* advances are scaled with the active size, so use its coordinates */
+    if ( size )
+    {
+      error = tt_size_select_var( size );
+      if ( error )
+        goto Exit;
+    }
 #endif
 
+    if ( flags & FT_LOAD_VERTICAL_LAYOUT )
+    {
       for ( nn = 0; nn < count; nn++ )
       {
         FT_Short   tsb;
@@ -253,13 +273,6 @@
     }
     else
     {
-#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
-      /* no fast retrieval for blended MM fonts without HVAR table */
-      if ( ( FT_IS_NAMED_INSTANCE( ttface ) || FT_IS_VARIATION( ttface ) ) &&
-           !( face->variation_support & TT_FACE_FLAG_VAR_HADVANCE )        )
-        return FT_THROW( Unimplemented_Feature );
-#endif
-
       for ( nn = 0; nn < count; nn++ )
       {
         FT_Short   lsb;
@@ -271,7 +284,17 @@
       }
     }
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    error = FT_Err_Ok;
+
+  Exit:
+    if ( size )
+      tt_size_unselect_var( size );
+
+    return error;
+#else
     return FT_Err_Ok;
+#endif
   }
 
 
@@ -470,8 +493,17 @@
                       ? &ttsize->metrics
                       : &size->hinted_metrics;
 
-    /* now fill in the glyph slot with outline/bitmap/layered */
+    /* now fill in the glyph slot with outline/bitmap/layered, */
+    /* using the size's variation coordinates, if any          */
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    error = tt_size_select_var( size );
+    if ( !error )
+      error = TT_Load_Glyph( size, slot, glyph_index, load_flags );
+
+    tt_size_unselect_var( size );
+#else
     error = TT_Load_Glyph( size, slot, glyph_index, load_flags );
+#endif
 
     /* force drop-out mode to 2 - irrelevant now */
     /* slot->outline.dropout_mode = 2; */
@@ -509,7 +541,10 @@
     (FT_Get_MM_WeightVector_Func)NULL,                  /* get_mm_weightvector */
 
     (FT_Get_Var_Blend_Func)      tt_get_var_blend,      /* get_var_blend       */
-    (FT_Done_Blend_Func)         tt_done_blend          /* done_blend          */
+    (FT_Done_Blend_Func)         tt_done_blend,         /* done_blend          */
+
+    (FT_Set_Size_Var_Func)       TT_Set_Size_MM_Blend,  /* set_size_mm_blend   */
+    (FT_Set_Size_Var_Func)       TT_Set_Size_Var_Design /* set_size_var_design */
   )
 
   FT_DEFINE_SERVICE_METRICSVARIATIONSREC(
@@ -547,12 +582,36 @@
   FT_DEFINE_SERVICE_TTGLYFREC(
     tt_service_truetype_glyf,
 
-    (TT_Glyf_GetLocationFunc)tt_face_get_location      /* get_location */
+    (TT_Glyf_GetLocationFunc)tt_face_get_location,     /* get_location */
+    (TT_Glyf_GetCBoxFunc)    TT_Get_CBox               /* get_cbox     */
+  )
+
+
+  static void
+  tt_face_purge( FT_Face  ttface )      /* TT_Face */
+  {
+    TT_Face       face = (TT_Face)ttface;
+    SFNT_Service  sfnt = (SFNT_Service)face->sfnt;
+
+
+    if ( sfnt && sfnt->free_psnames )
+      sfnt->free_psnames( face );
+
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    tt_purge_blend( face );
+#endif
+  }
+
+
+  FT_DEFINE_SERVICE_PURGEREC(
+    tt_service_purge,
+
+    (FT_Purge_Func)tt_face_purge    /* purge */
   )
 
 
 #ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
-  FT_DEFINE_SERVICEDESCREC6(
+  FT_DEFINE_SERVICEDESCREC7(
     tt_services,
 
     FT_SERVICE_ID_FONT_FORMAT,        FT_FONT_FORMAT_TRUETYPE,
@@ -560,15 +619,17 @@
     FT_SERVICE_ID_METRICS_VARIATIONS, &tt_service_metrics_variations,
     FT_SERVICE_ID_TRUETYPE_ENGINE,    &tt_service_truetype_engine,
     FT_SERVICE_ID_TT_GLYF,            &tt_service_truetype_glyf,
-    FT_SERVICE_ID_PROPERTIES,         &tt_service_properties )
+    FT_SERVICE_ID_PROPERTIES,         &tt_service_properties,
+    FT_SERVICE_ID_PURGE,              &tt_service_purge )
 #else
-  FT_DEFINE_SERVICEDESCREC4(
+  FT_DEFINE_SERVICEDESCREC5(
     tt_services,
 
     FT_SERVICE_ID_FONT_FORMAT,     FT_FONT_FORMAT_TRUETYPE,
     FT_SERVICE_ID_TRUETYPE_ENGINE, &tt_service_truetype_engine,
     FT_SERVICE_ID_TT_GLYF,         &tt_service_truetype_glyf,
-    FT_SERVICE_ID_PROPERTIES,      &tt_service_properties )
+    FT_SERVICE_ID_PROPERTIES,      &tt_service_properties,
+    FT_SERVICE_ID_PURGE,           &tt_service_purge )
 #endif
 
 
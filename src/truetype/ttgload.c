@@ -1008,9 +1008,7 @@
       TT_Face    face   = loader->face;
       TT_Driver  driver = (TT_Driver)FT_FACE_DRIVER( face );
 
-      FT_String*  family         = face->root.family_name;
       FT_UInt     ppem           = loader->size->metrics->x_ppem;
-      FT_String*  style          = face->root.style_name;
       FT_UInt     x_scale_factor = 1000;
 #endif
 
@@ -1030,9 +1028,7 @@
         /* scale, but only if enabled and only if TT hinting is being used */
         if ( IS_HINTED( loader->load_flags ) )
           x_scale_factor = sph_test_tweak_x_scaling( face,
-                                                     family,
                                                      ppem,
-                                                     style,
                                                      loader->glyph_index );
         /* scale the glyph */
         if ( ( loader->load_flags & FT_LOAD_NO_SCALE ) == 0 ||
@@ -1583,6 +1579,35 @@
   }
 
 
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+
+  /* Prefetch the data of a composite glyph's components.  Errors are */
+  /* ignored since the components get loaded one by one anyway.       */
+  static void
+  tt_prefetch_subglyphs( TT_Face      face,
+                         FT_SubGlyph  subglyphs,
+                         FT_UInt      num_subglyphs )
+  {
+    FT_Memory  memory  = face->root.memory;
+    FT_UInt*   indices = NULL;
+    FT_Error   error;
+    FT_UInt    n;
+
+
+    if ( FT_QNEW_ARRAY( indices, num_subglyphs ) )
+      return;
+
+    for ( n = 0; n < num_subglyphs; n++ )
+      indices[n] = (FT_UInt)subglyphs[n].index;
+
+    (void)FT_Incremental_Prefetch( FT_FACE( face ), num_subglyphs, indices );
+
+    FT_FREE( indices );
+  }
+
+#endif /* FT_CONFIG_OPTION_INCREMENTAL */
+
+
   /**************************************************************************
    *
    * @Function:
@@ -1659,9 +1684,9 @@
     /* by the interface.                                               */
     if ( face->root.internal->incremental_interface )
     {
-      error = face->root.internal->incremental_interface->funcs->get_glyph_data(
-                face->root.internal->incremental_interface->object,
-                glyph_index, &glyph_data );
+      error = ft_incremental_get_glyph_data( FT_FACE( face ),
+                                             glyph_index,
+                                             &glyph_data );
       if ( error )
         goto Exit;
 
@@ -2100,6 +2125,15 @@
 
         FT_GlyphLoader_Add( gloader );
 
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+        /* fetch the data of all components with a single call */
+        if ( face->root.internal->incremental_batch &&
+             num_subglyphs > 1                      )
+          tt_prefetch_subglyphs( face,
+                                 gloader->base.subglyphs + num_base_subgs,
+                                 num_subglyphs );
+#endif
+
         /* read each subglyph independently */
         for ( n = 0; n < num_subglyphs; n++ )
         {
@@ -2518,6 +2552,14 @@
       FT_Bool  reexecute = FALSE;
 
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+      /* the `prep' table must be re-executed for other coordinates */
+      if ( face->doblend                                           &&
+           ( !face->blend->instance                              ||
+             face->blend->instance->id != size->var_instance_id ) )
+        size->cvt_ready = -1;
+#endif
+
       if ( size->bytecode_ready < 0 || size->cvt_ready < 0 )
       {
         error = tt_size_ready_bytecode( size, pedantic );
@@ -3018,4 +3060,134 @@
   }
 
 
+  /**************************************************************************
+   *
+   * @Function:
+   *   TT_Get_CBox
+   *
+   * @Description:
+   *   Get the control box of an unhinted glyph outline from the bounding
+   *   box stored in its `glyf' header, without loading the outline.
+   *
+   * @Input:
+   *   face ::
+   *     A handle to the target face object.
+   *
+   *   glyph_index ::
+   *     The index of the glyph in the font file.
+   *
+   *   load_flags ::
+   *     Only @FT_LOAD_NO_SCALE is taken into account.
+   *
+   * @Output:
+   *   acbox ::
+   *     The control box, in font units or 26.6 pixels, positioned like
+   *     the outline returned by `TT_Load_Glyph'.
+   *
+   * @Return:
+   *   FreeType error code.  0 means success.  `Unimplemented_Feature'
+   *   is returned if the header can't be trusted for this face; the
+   *   caller must then load the glyph.
+   */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Get_CBox( TT_Face   face,
+               FT_UInt   glyph_index,
+               FT_Int32  load_flags,
+               FT_BBox  *acbox )
+  {
+    FT_Error   error;
+    FT_Stream  stream = face->root.stream;
+    TT_Size    size   = (TT_Size)face->root.size;
+
+    FT_ULong   offset;
+    FT_UInt    byte_len;
+    FT_Short   n_contours = 0;
+    FT_BBox    bbox;
+    FT_Pos     pp1;
+
+    FT_Short   left_bearing  = 0;
+    FT_UShort  advance_width = 0;
+
+
+    /* bytecode-assembled glyphs and variation deltas */
+    /* change the outline beyond the stored box       */
+    if ( FT_IS_TRICKY( FT_FACE( face ) ) )
+      return FT_THROW( Unimplemented_Feature );
+
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    if ( !IS_DEFAULT_INSTANCE( FT_FACE( face ) ) ||
+         face->doblend                          ||
+         ( size && size->var_coords )           )
+      return FT_THROW( Unimplemented_Feature );
+#endif
+
+#ifdef FT_CONFIG_OPTION_INCREMENTAL
+    if ( face->root.internal->incremental_interface )
+      return FT_THROW( Unimplemented_Feature );
+#endif
+
+    if ( !face->glyf_offset )
+      return FT_THROW( Unimplemented_Feature );
+
+    if ( !( load_flags & FT_LOAD_NO_SCALE ) && !size )
+      return FT_THROW( Invalid_Size_Handle );
+
+    FT_ZERO( &bbox );
+
+    offset = tt_face_get_location( face, glyph_index, &byte_len );
+    if ( byte_len > 0 )
+    {
+      if ( byte_len < 10 )
+        return FT_THROW( Invalid_Outline );
+
+      if ( FT_STREAM_SEEK( face->glyf_offset + offset ) ||
+           FT_FRAME_ENTER( 10L )                        )
+        return error;
+
+      n_contours = FT_GET_SHORT();
+      bbox.xMin  = FT_GET_SHORT();
+      bbox.yMin  = FT_GET_SHORT();
+      bbox.xMax  = FT_GET_SHORT();
+      bbox.yMax  = FT_GET_SHORT();
+
+      FT_FRAME_EXIT();
+    }
+
+    /* a space glyph has an empty outline */
+    if ( n_contours == 0 )
+    {
+      FT_ZERO( acbox );
+      return FT_Err_Ok;
+    }
+
+    /* `TT_Load_Glyph' moves the outline so that `pp1' is the origin */
+    TT_Get_HMetrics( face, glyph_index, &left_bearing, &advance_width );
+    pp1 = bbox.xMin - left_bearing;
+
+    if ( load_flags & FT_LOAD_NO_SCALE )
+    {
+      acbox->xMin = bbox.xMin - pp1;
+      acbox->xMax = bbox.xMax - pp1;
+      acbox->yMin = bbox.yMin;
+      acbox->yMax = bbox.yMax;
+    }
+    else
+    {
+      /* scale like the outline points, including `pp1' */
+      FT_Fixed  x_scale = size->metrics->x_scale;
+      FT_Fixed  y_scale = size->metrics->y_scale;
+
+
+      pp1 = FT_MulFix( pp1, x_scale );
+
+      acbox->xMin = FT_MulFix( bbox.xMin, x_scale ) - pp1;
+      acbox->xMax = FT_MulFix( bbox.xMax, x_scale ) - pp1;
+      acbox->yMin = FT_MulFix( bbox.yMin, y_scale );
+      acbox->yMax = FT_MulFix( bbox.yMax, y_scale );
+    }
+
+    return FT_Err_Ok;
+  }
+
+
 /* END */
@@ -52,6 +52,12 @@ FT_BEGIN_HEADER
                  FT_UInt       glyph_index,
                  FT_Int32      load_flags );
 
+  FT_LOCAL( FT_Error )
+  TT_Get_CBox( TT_Face   face,
+               FT_UInt   glyph_index,
+               FT_Int32  load_flags,
+               FT_BBox  *acbox );
+
 
 FT_END_HEADER
 
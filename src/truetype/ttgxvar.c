@@ -525,6 +525,9 @@
 
     /* end of region list parse */
 
+    if ( FT_NEW_ARRAY( itemStore->regionScalars, itemStore->regionCount ) )
+      goto Exit;
+
     /* use dataOffsetArray now to parse varData items */
     if ( FT_NEW_ARRAY( itemStore->varData, itemStore->dataCount ) )
       goto Exit;
@@ -863,34 +866,23 @@
   }
 
 
-  static FT_Int
-  ft_var_get_item_delta( TT_Face          face,
-                         GX_ItemVarStore  itemStore,
-                         FT_UInt          outerIndex,
-                         FT_UInt          innerIndex )
+  /* compute the scalars of all regions for the current coordinates */
+  static void
+  ft_var_compute_region_scalars( TT_Face          face,
+                                 GX_ItemVarStore  itemStore )
   {
-    GX_ItemVarData  varData;
-    FT_Short*       deltaSet;
-
-    FT_UInt   master, j;
-    FT_Fixed  netAdjustment = 0;     /* accumulated adjustment */
-    FT_Fixed  scaledDelta;
-    FT_Fixed  delta;
+    FT_Fixed*  coords = face->blend->normalizedcoords;
+    FT_UInt    region, j;
 
 
     /* See pseudo code from `Font Variations Overview' */
     /* in the OpenType specification.                  */
 
-    varData  = &itemStore->varData[outerIndex];
-    deltaSet = &varData->deltaSet[varData->regionIdxCount * innerIndex];
-
-    /* outer loop steps through master designs to be blended */
-    for ( master = 0; master < varData->regionIdxCount; master++ )
+    for ( region = 0; region < itemStore->regionCount; region++ )
     {
-      FT_Fixed  scalar      = 0x10000L;
-      FT_UInt   regionIndex = varData->regionIndices[master];
+      FT_Fixed  scalar = 0x10000L;
 
-      GX_AxisCoords  axis = itemStore->varRegionList[regionIndex].axisList;
+      GX_AxisCoords  axis = itemStore->varRegionList[region].axisList;
 
 
       /* inner loop steps through axes in this region */
@@ -911,30 +903,67 @@
         else if ( axis->peakCoord == 0 )
           continue;
 
-        else if ( face->blend->normalizedcoords[j] == axis->peakCoord )
+        else if ( coords[j] == axis->peakCoord )
           continue;
 
         /* ignore this region if coords are out of range */
-        else if ( face->blend->normalizedcoords[j] <= axis->startCoord ||
-                  face->blend->normalizedcoords[j] >= axis->endCoord   )
+        else if ( coords[j] <= axis->startCoord ||
+                  coords[j] >= axis->endCoord   )
         {
           scalar = 0;
           break;
         }
 
         /* cumulative product of all the axis scalars */
-        else if ( face->blend->normalizedcoords[j] < axis->peakCoord )
+        else if ( coords[j] < axis->peakCoord )
           scalar =
             FT_MulDiv( scalar,
-                       face->blend->normalizedcoords[j] - axis->startCoord,
+                       coords[j] - axis->startCoord,
                        axis->peakCoord - axis->startCoord );
         else
           scalar =
             FT_MulDiv( scalar,
-                       axis->endCoord - face->blend->normalizedcoords[j],
+                       axis->endCoord - coords[j],
                        axis->endCoord - axis->peakCoord );
       } /* per-axis loop */
 
+      itemStore->regionScalars[region] = scalar;
+
+    } /* per-region loop */
+
+    itemStore->scalarsSerial = face->blend->coords_serial;
+  }
+
+
+  static FT_Int
+  ft_var_get_item_delta( TT_Face          face,
+                         GX_ItemVarStore  itemStore,
+                         FT_UInt          outerIndex,
+                         FT_UInt          innerIndex )
+  {
+    GX_ItemVarData  varData;
+    FT_Short*       deltaSet;
+
+    FT_UInt   master;
+    FT_Fixed  netAdjustment = 0;     /* accumulated adjustment */
+    FT_Fixed  scaledDelta;
+    FT_Fixed  delta;
+
+
+    /* region scalars only change with the coordinates */
+    if ( itemStore->scalarsSerial != face->blend->coords_serial )
+      ft_var_compute_region_scalars( face, itemStore );
+
+    varData  = &itemStore->varData[outerIndex];
+    deltaSet = &varData->deltaSet[varData->regionIdxCount * innerIndex];
+
+    /* outer loop steps through master designs to be blended */
+    for ( master = 0; master < varData->regionIdxCount; master++ )
+    {
+      FT_Fixed  scalar =
+                  itemStore->regionScalars[varData->regionIndices[master]];
+
+
       /* get the scaled delta for this region */
       delta       = FT_intToFixed( deltaSet[master] );
       scaledDelta = FT_MulFix( scalar, delta );
@@ -1334,10 +1363,16 @@
     FT_Short  mvar_hdsc_delta = 0;
     FT_Short  mvar_hlgp_delta = 0;
 
+    GX_InstanceData  instance = blend->instance;
+    FT_Short*        cached   = NULL;
+
 
     if ( !( face->variation_support & TT_FACE_FLAG_VAR_MVAR ) )
       return;
 
+    if ( instance )
+      cached = instance->mvar_deltas;
+
     value = blend->mvar_table->values;
     limit = value + blend->mvar_table->valueCount;
 
@@ -1347,10 +1382,17 @@
       FT_Int     delta;
 
 
-      delta = ft_var_get_item_delta( face,
-                                     &blend->mvar_table->itemStore,
-                                     value->outerIndex,
-                                     value->innerIndex );
+      if ( instance && instance->have_mvar )
+        delta = *cached++;
+      else
+      {
+        delta = ft_var_get_item_delta( face,
+                                       &blend->mvar_table->itemStore,
+                                       value->outerIndex,
+                                       value->innerIndex );
+        if ( cached )
+          *cached++ = (FT_Short)delta;
+      }
 
       if ( p )
       {
@@ -1378,6 +1420,9 @@
       }
     }
 
+    if ( instance )
+      instance->have_mvar = TRUE;
+
     /* adjust all derived values */
     {
       FT_Face  root = &face->root;
@@ -2501,6 +2546,160 @@
   }
 
 
+  /* Return the cached instance data for the current normalized       */
+  /* coordinates, moving it to the front of the MRU list.  A new entry */
+  /* replaces the least recently used one if the cache is full.  On    */
+  /* allocation failure we return NULL, and nothing gets cached.       */
+  /* `coords_serial' is set to the ID of the returned data; a new      */
+  /* entry (or no entry) gets a new ID.                                */
+  static GX_InstanceData
+  ft_var_get_instance_data( TT_Face  face )
+  {
+    GX_Blend         blend    = face->blend;
+    FT_Memory        memory   = face->root.memory;
+    FT_UInt          num_axis = blend->num_axis;
+    GX_InstanceData  data     = NULL;
+    FT_UInt          i;
+
+
+    for ( i = 0; i < blend->num_cached; i++ )
+    {
+      data = blend->cached[i];
+
+      if ( !ft_memcmp( data->normalizedcoords,
+                       blend->normalizedcoords,
+                       num_axis * sizeof ( FT_Fixed ) ) )
+        goto Found;
+    }
+
+    if ( blend->num_cached < GX_MAX_CACHED_INSTANCES )
+    {
+      FT_Error  error;
+      FT_UInt   num_mvar = blend->mvar_table
+                             ? blend->mvar_table->valueCount
+                             : 0;
+
+
+      /* allocate everything in a single block */
+      if ( FT_ALLOC( data,
+                     sizeof ( GX_InstanceDataRec )                     +
+                       2 * num_axis * sizeof ( FT_Fixed )              +
+                       ( face->cvt_size + num_mvar ) * sizeof ( FT_Short ) ) )
+      {
+        blend->coords_serial = ++blend->last_serial;
+        return NULL;
+      }
+
+      data->normalizedcoords = (FT_Fixed*)( data + 1 );
+      data->coords           = data->normalizedcoords + num_axis;
+      data->cvt              = (FT_Short*)( data->coords + num_axis );
+      data->mvar_deltas      = data->cvt + face->cvt_size;
+
+      i = blend->num_cached++;
+    }
+    else
+    {
+      i    = GX_MAX_CACHED_INSTANCES - 1;
+      data = blend->cached[i];
+    }
+
+    FT_MEM_COPY( data->normalizedcoords,
+                 blend->normalizedcoords,
+                 num_axis * sizeof ( FT_Fixed ) );
+
+    data->id          = ++blend->last_serial;
+    data->have_coords = FALSE;
+    data->have_cvt    = FALSE;
+    data->have_mvar   = FALSE;
+
+  Found:
+    for ( ; i > 0; i-- )
+      blend->cached[i] = blend->cached[i - 1];
+    blend->cached[0] = data;
+
+    blend->coords_serial = data->id;
+
+    return data;
+  }
+
+
+  /* Look up normalized coordinates for the first `num_coords' design */
+  /* coordinates in `blend->coords'; return TRUE if found.            */
+  static FT_Bool
+  ft_var_find_normalized( GX_Blend   blend,
+                          FT_UInt    num_coords,
+                          FT_Fixed*  normalized )
+  {
+    FT_UInt  i;
+
+
+    for ( i = 0; i < blend->num_cached; i++ )
+    {
+      GX_InstanceData  data = blend->cached[i];
+
+
+      if ( data->have_coords                                  &&
+           data->num_coords == num_coords                     &&
+           !ft_memcmp( data->coords,
+                       blend->coords,
+                       num_coords * sizeof ( FT_Fixed ) )     )
+      {
+        FT_MEM_COPY( normalized,
+                     data->normalizedcoords,
+                     blend->num_axis * sizeof ( FT_Fixed ) );
+        return TRUE;
+      }
+    }
+
+    return FALSE;
+  }
+
+
+  /* Bring `face->cvt' in sync with the current coordinates.  If */
+  /* `reload' isn't set, the table still holds unvaried values.   */
+  static FT_Error
+  ft_var_update_cvt( TT_Face  face,
+                     FT_Bool  reload )
+  {
+    GX_InstanceData  instance = face->blend->instance;
+    FT_Memory        memory   = face->root.memory;
+    FT_Error         error;
+
+
+    if ( !face->cvt )
+      return FT_Err_Ok;
+
+    if ( instance && instance->have_cvt )
+    {
+      /* we have seen these coordinates recently */
+      FT_MEM_COPY( face->cvt,
+                   instance->cvt,
+                   face->cvt_size * sizeof ( FT_Short ) );
+      return FT_Err_Ok;
+    }
+
+    if ( reload )
+    {
+      FT_FREE( face->cvt );
+      face->cvt = NULL;
+
+      error = tt_face_load_cvt( face, face->root.stream );
+    }
+    else
+      error = tt_face_vary_cvt( face, face->root.stream );
+
+    if ( !error && face->cvt && instance )
+    {
+      FT_MEM_COPY( instance->cvt,
+                   face->cvt,
+                   face->cvt_size * sizeof ( FT_Short ) );
+      instance->have_cvt = TRUE;
+    }
+
+    return error;
+  }
+
+
   static FT_Error
   tt_set_mm_blend( TT_Face    face,
                    FT_UInt    num_coords,
@@ -2664,6 +2863,8 @@
 
     face->doblend = TRUE;
 
+    blend->instance = ft_var_get_instance_data( face );
+
     if ( face->cvt )
     {
       switch ( manageCvt )
@@ -2671,16 +2872,13 @@
       case mcvt_load:
         /* The cvt table has been loaded already; every time we change the */
         /* blend we may need to reload and remodify the cvt table.         */
-        FT_FREE( face->cvt );
-        face->cvt = NULL;
-
-        error = tt_face_load_cvt( face, face->root.stream );
+        error = ft_var_update_cvt( face, TRUE );
         break;
 
       case mcvt_modify:
         /* The original cvt table is in memory.  All we need to do is */
         /* apply the `cvar' table (if any).                           */
-        error = tt_face_vary_cvt( face, face->root.stream );
+        error = ft_var_update_cvt( face, FALSE );
         break;
 
       case mcvt_retain:
@@ -2949,17 +3147,30 @@
     if ( FT_NEW_ARRAY( normalized, mmvar->num_axis ) )
       goto Exit;
 
-    if ( !face->blend->avar_loaded )
-      ft_var_load_avar( face );
+    if ( !ft_var_find_normalized( blend, num_coords, normalized ) )
+    {
+      if ( !face->blend->avar_loaded )
+        ft_var_load_avar( face );
 
-    FT_TRACE5(( "TT_Set_Var_Design:\n"
-                "  normalized design coordinates:\n" ));
-    ft_var_to_normalized( face, num_coords, blend->coords, normalized );
+      FT_TRACE5(( "TT_Set_Var_Design:\n"
+                  "  normalized design coordinates:\n" ));
+      ft_var_to_normalized( face, num_coords, blend->coords, normalized );
+    }
 
     error = tt_set_mm_blend( face, mmvar->num_axis, normalized, 0 );
     if ( error )
       goto Exit;
 
+    /* remember the design coordinates of this instance */
+    if ( blend->instance )
+    {
+      FT_MEM_COPY( blend->instance->coords,
+                   blend->coords,
+                   num_coords * sizeof ( FT_Fixed ) );
+      blend->instance->num_coords  = num_coords;
+      blend->instance->have_coords = TRUE;
+    }
+
     if ( num_coords )
       face->root.face_flags |= FT_FACE_FLAG_VARIATION;
     else
@@ -3143,30 +3354,229 @@
   }
 
 
-  /*************************************************************************/
-  /*************************************************************************/
-  /*****                                                               *****/
-  /*****                     GX VAR PARSING ROUTINES                   *****/
-  /*****                                                               *****/
-  /*************************************************************************/
-  /*************************************************************************/
+  /* Switch the face to the normalized coordinates `coords' without */
+  /* touching anything visible to the user.                         */
+  static FT_Error
+  ft_var_switch_coords( TT_Face    face,
+                        FT_Fixed*  coords )
+  {
+    GX_Blend  blend = face->blend;
+
+
+    if ( !ft_memcmp( blend->normalizedcoords,
+                     coords,
+                     blend->num_axis * sizeof ( FT_Fixed ) ) )
+      return FT_Err_Ok;
+
+    FT_MEM_COPY( blend->normalizedcoords,
+                 coords,
+                 blend->num_axis * sizeof ( FT_Fixed ) );
+
+    blend->instance = ft_var_get_instance_data( face );
+
+    return ft_var_update_cvt( face, TRUE );
+  }
 
 
   static FT_Error
-  tt_cvt_ready_iterator( FT_ListNode  node,
-                         void*        user )
+  tt_set_size_coords( TT_Size    size,
+                      FT_UInt    num_coords,
+                      FT_Fixed*  coords,
+                      FT_Bool    design )
   {
-    TT_Size  size = (TT_Size)node->data;
+    TT_Face     face   = (TT_Face)size->root.face;
+    FT_Memory   memory = face->root.memory;
+    FT_Error    error;
+    GX_Blend    blend;
+    FT_MM_Var*  mmvar;
+    FT_UInt     i;
 
-    FT_UNUSED( user );
 
+    if ( !num_coords && !coords )
+    {
+      /* use the face's coordinates again */
+      FT_FREE( size->var_coords );
+      return FT_Err_Ok;
+    }
 
-    size->cvt_ready = -1;
+    if ( !face->blend )
+    {
+      if ( FT_SET_ERROR( TT_Get_MM_Var( face, NULL ) ) )
+        goto Exit;
+    }
 
-    return FT_Err_Ok;
+    blend = face->blend;
+    mmvar = blend->mmvar;
+
+    if ( num_coords > mmvar->num_axis )
+    {
+      FT_TRACE2(( "tt_set_size_coords:"
+                  " only using first %d of %d coordinates\n",
+                  mmvar->num_axis, num_coords ));
+      num_coords = mmvar->num_axis;
+    }
+
+    if ( !design )
+    {
+      for ( i = 0; i < num_coords; i++ )
+        if ( coords[i] < -0x00010000L || coords[i] > 0x00010000L )
+        {
+          FT_TRACE1(( "tt_set_size_coords:"
+                      " normalized design coordinate %.5f\n"
+                      "                    is out of range [-1;1]\n",
+                      coords[i] / 65536.0 ));
+          error = FT_THROW( Invalid_Argument );
+          goto Exit;
+        }
+    }
+
+    /* the face needs coordinates to switch back to */
+    if ( !blend->normalizedcoords )
+    {
+      if ( FT_SET_ERROR( tt_set_mm_blend( face, 0, NULL, 1 ) ) )
+        goto Exit;
+    }
+
+    if ( !blend->face_coords )
+    {
+      if ( FT_NEW_ARRAY( blend->face_coords, mmvar->num_axis ) )
+        goto Exit;
+    }
+
+    if ( !size->var_coords )
+    {
+      if ( FT_NEW_ARRAY( size->var_coords, mmvar->num_axis ) )
+        goto Exit;
+    }
+
+    if ( design )
+    {
+      if ( !blend->avar_loaded )
+        ft_var_load_avar( face );
+
+      ft_var_to_normalized( face, num_coords, coords, size->var_coords );
+    }
+    else
+    {
+      for ( i = 0; i < num_coords; i++ )
+        size->var_coords[i] = coords[i];
+      for ( ; i < mmvar->num_axis; i++ )
+        size->var_coords[i] = 0;
+    }
+
+    error = FT_Err_Ok;
+
+  Exit:
+    return error;
   }
 
 
+  /**************************************************************************
+   *
+   * @Function:
+   *   TT_Set_Size_MM_Blend
+   *
+   * @Description:
+   *   Set the normalized coordinates used for glyphs loaded with a given
+   *   size, independently of the face's coordinates.
+   *
+   * @Input:
+   *   size ::
+   *     A handle to the size object.
+   *
+   *   num_coords ::
+   *     The number of available coordinates.
+   *
+   *   coords ::
+   *     An array of `num_coords', each between [-1,1].  If `num_coords'
+   *     is zero and `coords' is NULL, the size uses the face's
+   *     coordinates again.
+   *
+   * @Return:
+   *   FreeType error code.  0 means success.
+   */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Set_Size_MM_Blend( TT_Size    size,
+                        FT_UInt    num_coords,
+                        FT_Fixed*  coords )
+  {
+    return tt_set_size_coords( size, num_coords, coords, 0 );
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   TT_Set_Size_Var_Design
+   *
+   * @Description:
+   *   Like `TT_Set_Size_MM_Blend', but for design coordinates.
+   */
+  FT_LOCAL_DEF( FT_Error )
+  TT_Set_Size_Var_Design( TT_Size    size,
+                          FT_UInt    num_coords,
+                          FT_Fixed*  coords )
+  {
+    return tt_set_size_coords( size, num_coords, coords, 1 );
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   tt_size_select_var
+   *
+   * @Description:
+   *   Temporarily switch the face to the size's variation coordinates
+   *   (if any).  Must be paired with a call to `tt_size_unselect_var'.
+   *
+   * @Input:
+   *   size ::
+   *     A handle to the size object.
+   *
+   * @Return:
+   *   FreeType error code.  0 means success.
+   */
+  FT_LOCAL_DEF( FT_Error )
+  tt_size_select_var( TT_Size  size )
+  {
+    TT_Face   face  = (TT_Face)size->root.face;
+    GX_Blend  blend = face->blend;
+
+
+    if ( !size->var_coords )
+      return FT_Err_Ok;
+
+    FT_MEM_COPY( blend->face_coords,
+                 blend->normalizedcoords,
+                 blend->num_axis * sizeof ( FT_Fixed ) );
+
+    return ft_var_switch_coords( face, size->var_coords );
+  }
+
+
+  FT_LOCAL_DEF( void )
+  tt_size_unselect_var( TT_Size  size )
+  {
+    TT_Face  face = (TT_Face)size->root.face;
+
+
+    if ( !size->var_coords )
+      return;
+
+    (void)ft_var_switch_coords( face, face->blend->face_coords );
+  }
+
+
+  /*************************************************************************/
+  /*************************************************************************/
+  /*****                                                               *****/
+  /*****                     GX VAR PARSING ROUTINES                   *****/
+  /*****                                                               *****/
+  /*************************************************************************/
+  /*************************************************************************/
+
+
   /**************************************************************************
    *
    * @Function:
@@ -3197,8 +3607,6 @@
     FT_Error   error;
     FT_Memory  memory = stream->memory;
 
-    FT_Face  root = &face->root;
-
     FT_ULong  table_start;
     FT_ULong  table_len;
 
@@ -3507,11 +3915,8 @@
     FT_FREE( im_end_coords );
     FT_FREE( cvt_deltas );
 
-    /* iterate over all FT_Size objects and set `cvt_ready' to -1 */
-    /* to trigger rescaling of all CVT values                     */
-    FT_List_Iterate( &root->sizes_list,
-                     tt_cvt_ready_iterator,
-                     NULL );
+    /* sizes notice the change by comparing the instance IDs */
+    /* and re-execute the `prep' table (see `tt_loader_init') */
 
     return error;
   }
@@ -4243,6 +4648,66 @@
 
       FT_FREE( itemStore->varRegionList );
     }
+
+    FT_FREE( itemStore->regionScalars );
+  }
+
+
+  static void
+  ft_var_done_hvvar( TT_Face         face,
+                     GX_HVVarTable  *atable )
+  {
+    FT_Memory      memory = FT_FACE_MEMORY( face );
+    GX_HVVarTable  table  = *atable;
+
+
+    if ( table )
+    {
+      ft_var_done_item_variation_store( face, &table->itemStore );
+
+      FT_FREE( table->widthMap.innerIndex );
+      FT_FREE( table->widthMap.outerIndex );
+      FT_FREE( *atable );
+    }
+  }
+
+
+  /**************************************************************************
+   *
+   * @Function:
+   *   tt_purge_blend
+   *
+   * @Description:
+   *   Free the parsed `HVAR' and `VVAR' tables (they get reloaded on
+   *   demand) and all cached instance data except the current one.
+   */
+  FT_LOCAL_DEF( void )
+  tt_purge_blend( TT_Face  face )
+  {
+    FT_Memory  memory = FT_FACE_MEMORY( face );
+    GX_Blend   blend  = face->blend;
+    FT_UInt    i;
+
+
+    if ( !blend )
+      return;
+
+    ft_var_done_hvvar( face, &blend->hvar_table );
+    blend->hvar_loaded  = FALSE;
+    blend->hvar_checked = FALSE;
+
+    ft_var_done_hvvar( face, &blend->vvar_table );
+    blend->vvar_loaded  = FALSE;
+    blend->vvar_checked = FALSE;
+
+    for ( i = 0; i < blend->num_cached; i++ )
+    {
+      if ( blend->cached[i] != blend->instance )
+        FT_FREE( blend->cached[i] );
+    }
+
+    blend->cached[0]  = blend->instance;
+    blend->num_cached = blend->instance ? 1 : 0;
   }
 
 
@@ -4271,6 +4736,7 @@
 
       FT_FREE( blend->coords );
       FT_FREE( blend->normalizedcoords );
+      FT_FREE( blend->face_coords );
       FT_FREE( blend->normalized_stylecoords );
       FT_FREE( blend->mmvar );
 
@@ -4281,25 +4747,8 @@
         FT_FREE( blend->avar_segment );
       }
 
-      if ( blend->hvar_table )
-      {
-        ft_var_done_item_variation_store( face,
-                                          &blend->hvar_table->itemStore );
-
-        FT_FREE( blend->hvar_table->widthMap.innerIndex );
-        FT_FREE( blend->hvar_table->widthMap.outerIndex );
-        FT_FREE( blend->hvar_table );
-      }
-
-      if ( blend->vvar_table )
-      {
-        ft_var_done_item_variation_store( face,
-                                          &blend->vvar_table->itemStore );
-
-        FT_FREE( blend->vvar_table->widthMap.innerIndex );
-        FT_FREE( blend->vvar_table->widthMap.outerIndex );
-        FT_FREE( blend->vvar_table );
-      }
+      ft_var_done_hvvar( face, &blend->hvar_table );
+      ft_var_done_hvvar( face, &blend->vvar_table );
 
       if ( blend->mvar_table )
       {
@@ -4310,6 +4759,9 @@
         FT_FREE( blend->mvar_table );
       }
 
+      for ( i = 0; i < blend->num_cached; i++ )
+        FT_FREE( blend->cached[i] );
+
       FT_FREE( blend->tuplecoords );
       FT_FREE( blend->glyphoffsets );
       FT_FREE( blend );
@@ -101,6 +101,10 @@ FT_BEGIN_HEADER
     FT_UInt       regionCount;          /* total number of regions defined */
     GX_VarRegion  varRegionList;
 
+    FT_Fixed*     regionScalars;        /* scalars of all regions for the  */
+                                        /* blend's current coordinates     */
+    FT_ULong      scalarsSerial;        /* `coords_serial' of the scalars  */
+
   } GX_ItemVarStoreRec, *GX_ItemVarStore;
 
 
@@ -208,6 +212,38 @@ FT_BEGIN_HEADER
   } GX_MVarTableRec, *GX_MVarTable;
 
 
+  /**************************************************************************
+   *
+   * @Struct:
+   *   GX_InstanceDataRec
+   *
+   * @Description:
+   *   Data derived from a set of normalized coordinates.  The most
+   *   recently used sets are cached so that switching back and forth
+   *   between a few instances doesn't recompute them.
+   */
+  typedef struct  GX_InstanceDataRec_
+  {
+    FT_ULong   id;                          /* unique within the blend    */
+    FT_Fixed*  normalizedcoords;            /* normalizedcoords[num_axis] */
+
+    FT_Bool    have_coords;
+    FT_UInt    num_coords;
+    FT_Fixed*  coords;       /* design coordinates mapping to the above; */
+                             /* only the first `num_coords' are used     */
+
+    FT_Bool    have_cvt;
+    FT_Short*  cvt;                  /* the varied `cvt ' table           */
+
+    FT_Bool    have_mvar;
+    FT_Short*  mvar_deltas;          /* one delta per `MVAR' value record */
+
+  } GX_InstanceDataRec, *GX_InstanceData;
+
+
+#define GX_MAX_CACHED_INSTANCES  8
+
+
   /**************************************************************************
    *
    * @Struct:
@@ -332,6 +368,21 @@ FT_BEGIN_HEADER
 
     FT_ULong        gvar_size;
 
+    /* identifies `normalizedcoords'; equal to `instance->id' if there */
+    /* is an instance, and never reused for other coordinates          */
+    FT_ULong         coords_serial;
+    FT_ULong         last_serial;
+
+    /* data for the current coordinates (or NULL) */
+    GX_InstanceData  instance;
+
+    /* the face's own coordinates while a size's ones are selected */
+    FT_Fixed*        face_coords;
+
+    /* most recently used first */
+    FT_UInt          num_cached;
+    GX_InstanceData  cached[GX_MAX_CACHED_INSTANCES];
+
   } GX_BlendRec;
 
 
@@ -406,6 +457,22 @@ FT_BEGIN_HEADER
   TT_Set_Named_Instance( TT_Face  face,
                          FT_UInt  instance_index );
 
+  FT_LOCAL( FT_Error )
+  TT_Set_Size_MM_Blend( TT_Size    size,
+                        FT_UInt    num_coords,
+                        FT_Fixed*  coords );
+
+  FT_LOCAL( FT_Error )
+  TT_Set_Size_Var_Design( TT_Size    size,
+                          FT_UInt    num_coords,
+                          FT_Fixed*  coords );
+
+  FT_LOCAL( FT_Error )
+  tt_size_select_var( TT_Size  size );
+
+  FT_LOCAL( void )
+  tt_size_unselect_var( TT_Size  size );
+
   FT_LOCAL( FT_Error )
   tt_face_vary_cvt( TT_Face    face,
                     FT_Stream  stream );
@@ -438,6 +505,9 @@ FT_BEGIN_HEADER
                     FT_Fixed*   *normalizedcoords,
                     FT_MM_Var*  *mm_var );
 
+  FT_LOCAL( void )
+  tt_purge_blend( TT_Face  face );
+
   FT_LOCAL( void )
   tt_done_blend( TT_Face  face );
 
@@ -433,67 +433,76 @@
       }
     };
 
-    FT_ULong   checksum;
-    int        num_matched_ids[TRICK_SFNT_IDS_NUM_FACES];
-    FT_Bool    has_cvt, has_fpgm, has_prep;
+    FT_UShort  idx[TRICK_SFNT_IDS_PER_FACE];
+    FT_ULong   length[TRICK_SFNT_IDS_PER_FACE];
+    FT_ULong   checksum[TRICK_SFNT_IDS_PER_FACE];
+    FT_Bool    has_checksum[TRICK_SFNT_IDS_PER_FACE];
     FT_UShort  i;
     int        j, k;
 
 
-    FT_MEM_SET( num_matched_ids, 0,
-                sizeof ( int ) * TRICK_SFNT_IDS_NUM_FACES );
-    has_cvt  = FALSE;
-    has_fpgm = FALSE;
-    has_prep = FALSE;
+    /* A missing table is treated as having length and checksum zero, */
+    /* which is how the table above represents it.                    */
+    for ( k = 0; k < TRICK_SFNT_IDS_PER_FACE; k++ )
+    {
+      idx[k]          = 0;
+      length[k]       = 0;
+      checksum[k]     = 0;
+      has_checksum[k] = TRUE;
+    }
 
+    /* First collect the table lengths from the font directory; this */
+    /* doesn't need any stream access.                               */
     for ( i = 0; i < face->num_tables; i++ )
     {
-      checksum = 0;
-
       switch( face->dir_tables[i].Tag )
       {
       case TTAG_cvt:
         k = TRICK_SFNT_ID_cvt;
-        has_cvt  = TRUE;
         break;
 
       case TTAG_fpgm:
         k = TRICK_SFNT_ID_fpgm;
-        has_fpgm = TRUE;
         break;
 
       case TTAG_prep:
         k = TRICK_SFNT_ID_prep;
-        has_prep = TRUE;
         break;
 
       default:
         continue;
       }
 
-      for ( j = 0; j < TRICK_SFNT_IDS_NUM_FACES; j++ )
-        if ( face->dir_tables[i].Length == sfnt_id[j][k].Length )
-        {
-          if ( !checksum )
-            checksum = tt_get_sfnt_checksum( face, i );
-
-          if ( sfnt_id[j][k].CheckSum == checksum )
-            num_matched_ids[j]++;
-
-          if ( num_matched_ids[j] == TRICK_SFNT_IDS_PER_FACE )
-            return TRUE;
-        }
+      idx[k]          = i;
+      length[k]       = face->dir_tables[i].Length;
+      has_checksum[k] = FALSE;
     }
 
+    /* Only if all three lengths match an entry we compute the checksums */
+    /* of the involved tables, each at most once.  For almost all fonts  */
+    /* that aren't tricky this means that no table data is read at all.  */
     for ( j = 0; j < TRICK_SFNT_IDS_NUM_FACES; j++ )
     {
-      if ( !has_cvt  && !sfnt_id[j][TRICK_SFNT_ID_cvt].Length )
-        num_matched_ids[j]++;
-      if ( !has_fpgm && !sfnt_id[j][TRICK_SFNT_ID_fpgm].Length )
-        num_matched_ids[j]++;
-      if ( !has_prep && !sfnt_id[j][TRICK_SFNT_ID_prep].Length )
-        num_matched_ids[j]++;
-      if ( num_matched_ids[j] == TRICK_SFNT_IDS_PER_FACE )
+      for ( k = 0; k < TRICK_SFNT_IDS_PER_FACE; k++ )
+        if ( length[k] != sfnt_id[j][k].Length )
+          break;
+
+      if ( k < TRICK_SFNT_IDS_PER_FACE )
+        continue;
+
+      for ( k = 0; k < TRICK_SFNT_IDS_PER_FACE; k++ )
+      {
+        if ( !has_checksum[k] )
+        {
+          checksum[k]     = tt_get_sfnt_checksum( face, idx[k] );
+          has_checksum[k] = TRUE;
+        }
+
+        if ( checksum[k] != sfnt_id[j][k].CheckSum )
+          break;
+      }
+
+      if ( k == TRICK_SFNT_IDS_PER_FACE )
         return TRUE;
     }
 
@@ -796,6 +805,13 @@
     FT_FREE( face->cvt );
     face->cvt_size = 0;
 
+#ifdef TT_SUPPORT_SUBPIXEL_HINTING_INFINALITY
+    /* freeing the compiled subpixel hinting rules */
+    FT_FREE( face->sph_rules );
+    face->sph_num_rules      = 0;
+    face->sph_rules_compiled = FALSE;
+#endif
+
     /* freeing the programs */
     FT_FRAME_RELEASE( face->font_program );
     FT_FRAME_RELEASE( face->cvt_program );
@@ -990,6 +1006,12 @@
 
     size->cvt_ready = error;
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    size->var_instance_id = ( face->doblend && face->blend->instance )
+                              ? face->blend->instance->id
+                              : 0;
+#endif
+
     /* UNDOCUMENTED!  The MS rasterizer doesn't allow the following */
     /* graphics state variables to be modified by the CVT program.  */
 
@@ -1276,6 +1298,15 @@
     tt_size_done_bytecode( ttsize );
 #endif
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    {
+      FT_Memory  memory = ttsize->face->memory;
+
+
+      FT_FREE( size->var_coords );
+    }
+#endif
+
     size->ttmetrics.valid = FALSE;
   }
 
@@ -1469,7 +1500,32 @@
   FT_LOCAL_DEF( FT_Error )
   tt_slot_init( FT_GlyphSlot  slot )
   {
-    return FT_GlyphLoader_CreateExtra( slot->internal->loader );
+    TT_Face         face    = (TT_Face)slot->face;
+    TT_MaxProfile*  maxp    = &face->max_profile;
+    FT_GlyphLoader  gloader = slot->internal->loader;
+
+    FT_UInt  n_points, n_contours, n_subglyphs;
+    FT_Error  error;
+
+
+    /* Size the glyph loader from the `maxp' table so that loading */
+    /* glyphs usually doesn't need to reallocate it; the four      */
+    /* additional points are the phantom points.                   */
+    n_points    = FT_MAX( maxp->maxPoints, maxp->maxCompositePoints );
+    n_contours  = FT_MAX( maxp->maxContours, maxp->maxCompositeContours );
+    n_subglyphs = maxp->maxComponentElements;
+
+    if ( n_points || n_contours )
+    {
+      error = FT_GlyphLoader_Presize( gloader,
+                                      n_points + 4,
+                                      n_contours,
+                                      n_subglyphs );
+      if ( error )
+        return error;
+    }
+
+    return FT_GlyphLoader_CreateExtra( gloader );
   }
 
 
@@ -318,8 +318,19 @@ FT_BEGIN_HEADER
     FT_Error           bytecode_ready;
     FT_Error           cvt_ready;
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    /* the variation instance `prep' was executed for */
+    FT_ULong           var_instance_id;
+#endif
+
 #endif /* TT_USE_BYTECODE_INTERPRETER */
 
+#ifdef TT_CONFIG_OPTION_GX_VAR_SUPPORT
+    /* normalized variation coordinates of this size; */
+    /* if NULL, the face's coordinates are used       */
+    FT_Fixed*          var_coords;
+#endif
+
   } TT_SizeRec;
 
 
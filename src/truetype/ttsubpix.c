@@ -814,99 +814,215 @@
   }
 
 
-  FT_LOCAL_DEF( FT_Bool )
-  sph_test_tweak( TT_Face               face,
-                  const FT_String*      family,
-                  FT_UInt               ppem,
-                  const FT_String*      style,
-                  FT_UInt               glyph_index,
-                  const SPH_TweakRule*  rule,
-                  FT_UInt               num_rules )
+  /* Pseudo tweak flags for rules that don't control the interpreter */
+  /* directly; they never show up in `sph_tweak_flags'.               */
+#define SPH_RULE_COMPATIBILITY_MODE  0x40000000UL
+#define SPH_RULE_COMPATIBLE_WIDTHS   0x80000000UL
+
+
+  typedef struct  SPH_RuleSet_
   {
-    FT_UInt  i;
+    const SPH_TweakRule*  rules;
+    FT_UInt               num_rules;
+    FT_ULong              set_flags;
+    FT_ULong              clear_flags;
 
+  } SPH_RuleSet;
 
-    /* rule checks may be able to be optimized further */
-    for ( i = 0; i < num_rules; i++ )
-    {
-      if ( family                                                   &&
-           ( is_member_of_family_class ( family, rule[i].family ) ) )
-        if ( rule[i].ppem == 0    ||
-             rule[i].ppem == ppem )
-          if ( style                                             &&
-               is_member_of_style_class ( style, rule[i].style ) )
-            if ( rule[i].glyph == 0                                ||
-                 FT_Get_Char_Index( (FT_Face)face,
-                                    rule[i].glyph ) == glyph_index )
-        return TRUE;
-    }
 
-    return FALSE;
+#define SPH_RULE_SET( x )                                  \
+          { x##_Rules, x##_RULES_SIZE,                     \
+            SPH_TWEAK_##x, 0 }
+#define SPH_RULE_SET_EXCEPTIONS( x )                       \
+          { x##_Rules_Exceptions, x##_RULES_EXCEPTIONS_SIZE, \
+            0, SPH_TWEAK_##x }
+
+
+  static const SPH_RuleSet  sph_rule_sets[] =
+  {
+    SPH_RULE_SET( PIXEL_HINTING ),
+    SPH_RULE_SET( ALLOW_X_DMOVE ),
+    SPH_RULE_SET( ALWAYS_DO_DELTAP ),
+    SPH_RULE_SET( ALWAYS_SKIP_DELTAP ),
+    SPH_RULE_SET( DEEMBOLDEN ),
+    SPH_RULE_SET( DO_SHPIX ),
+    SPH_RULE_SET( EMBOLDEN ),
+    SPH_RULE_SET( MIAP_HACK ),
+    SPH_RULE_SET( NORMAL_ROUND ),
+    SPH_RULE_SET( NO_ALIGNRP_AFTER_IUP ),
+    SPH_RULE_SET( NO_CALL_AFTER_IUP ),
+    SPH_RULE_SET( NO_DELTAP_AFTER_IUP ),
+    SPH_RULE_SET( RASTERIZER_35 ),
+    SPH_RULE_SET( SKIP_IUP ),
+    SPH_RULE_SET( SKIP_OFFPIXEL_Y_MOVES ),
+    SPH_RULE_SET_EXCEPTIONS( SKIP_OFFPIXEL_Y_MOVES ),
+    SPH_RULE_SET( SKIP_NONPIXEL_Y_MOVES_DELTAP ),
+    SPH_RULE_SET( SKIP_NONPIXEL_Y_MOVES ),
+    SPH_RULE_SET_EXCEPTIONS( SKIP_NONPIXEL_Y_MOVES ),
+    SPH_RULE_SET( ROUND_NONPIXEL_Y_MOVES ),
+    SPH_RULE_SET_EXCEPTIONS( ROUND_NONPIXEL_Y_MOVES ),
+    SPH_RULE_SET( TIMES_NEW_ROMAN_HACK ),
+    SPH_RULE_SET( COURIER_NEW_2_HACK ),
+    { COMPATIBILITY_MODE_Rules, COMPATIBILITY_MODE_RULES_SIZE,
+      SPH_RULE_COMPATIBILITY_MODE, 0 },
+    { COMPATIBLE_WIDTHS_Rules, COMPATIBLE_WIDTHS_RULES_SIZE,
+      SPH_RULE_COMPATIBLE_WIDTHS, 0 },
+  };
+
+#define SPH_NUM_RULE_SETS \
+          ( sizeof ( sph_rule_sets ) / sizeof ( sph_rule_sets[0] ) )
+
+
+  static FT_Bool
+  sph_rule_matches_face( TT_Face      face,
+                         const char*  rule_family,
+                         const char*  rule_style )
+  {
+    FT_String*  family = face->root.family_name;
+    FT_String*  style  = face->root.style_name;
+
+
+    return FT_BOOL( family                                           &&
+                    style                                            &&
+                    is_member_of_family_class( family, rule_family ) &&
+                    is_member_of_style_class( style, rule_style )    );
   }
 
 
-  static FT_UInt
-  scale_test_tweak( TT_Face               face,
-                    const FT_String*      family,
-                    FT_UInt               ppem,
-                    const FT_String*      style,
-                    FT_UInt               glyph_index,
-                    const SPH_ScaleRule*  rule,
-                    FT_UInt               num_rules )
+  /* Collect all rules whose family and style match the face, so that */
+  /* glyph loading only has to check the ppem and glyph conditions.   */
+  /* The string comparisons against the rule tables (and the family   */
+  /* and style classes) are thus done only once per face.             */
+  static void
+  sph_compile_rules( TT_Face  face )
   {
-    FT_UInt  i;
+    FT_Memory     memory = face->root.memory;
+    FT_Error      error;
+    SPH_FaceRule  rules  = NULL;
+    FT_UInt       count  = 0;
+    FT_UInt       pass, i, j;
+
 
+    face->sph_rules_compiled = TRUE;
 
-    /* rule checks may be able to be optimized further */
-    for ( i = 0; i < num_rules; i++ )
+    /* pass 0 counts the matching rules, pass 1 stores them */
+    for ( pass = 0; pass < 2; pass++ )
     {
-      if ( family                                                   &&
-           ( is_member_of_family_class ( family, rule[i].family ) ) )
-        if ( rule[i].ppem == 0    ||
-             rule[i].ppem == ppem )
-          if ( style                                            &&
-               is_member_of_style_class( style, rule[i].style ) )
-            if ( rule[i].glyph == 0                                ||
-                 FT_Get_Char_Index( (FT_Face)face,
-                                    rule[i].glyph ) == glyph_index )
-        return rule[i].scale;
+      count = 0;
+
+      for ( i = 0; i < SPH_NUM_RULE_SETS; i++ )
+      {
+        const SPH_RuleSet*  set = &sph_rule_sets[i];
+
+
+        for ( j = 0; j < set->num_rules; j++ )
+        {
+          const SPH_TweakRule*  rule = &set->rules[j];
+
+
+          if ( !sph_rule_matches_face( face, rule->family, rule->style ) )
+            continue;
+
+          if ( rules )
+          {
+            rules[count].set_flags   = set->set_flags;
+            rules[count].clear_flags = set->clear_flags;
+            rules[count].ppem        = rule->ppem;
+            rules[count].glyph       = rule->glyph;
+            rules[count].scale       = 0;
+          }
+          count++;
+        }
+      }
+
+      for ( j = 0; j < X_SCALING_RULES_SIZE; j++ )
+      {
+        const SPH_ScaleRule*  rule = &X_SCALING_Rules[j];
+
+
+        if ( !sph_rule_matches_face( face, rule->family, rule->style ) )
+          continue;
+
+        if ( rules )
+        {
+          rules[count].set_flags   = 0;
+          rules[count].clear_flags = 0;
+          rules[count].ppem        = rule->ppem;
+          rules[count].glyph       = rule->glyph;
+          rules[count].scale       = rule->scale;
+        }
+        count++;
+      }
+
+      if ( !count )
+        break;
+
+      if ( !rules && FT_QNEW_ARRAY( rules, count ) )
+      {
+        /* without memory we simply don't apply any tweaks */
+        count = 0;
+        break;
+      }
     }
 
-    return 1000;
+    face->sph_rules     = rules;
+    face->sph_num_rules = count;
   }
 
 
-  FT_LOCAL_DEF( FT_UInt )
-  sph_test_tweak_x_scaling( TT_Face           face,
-                            const FT_String*  family,
-                            FT_UInt           ppem,
-                            const FT_String*  style,
-                            FT_UInt           glyph_index )
-  {
-    return scale_test_tweak( face, family, ppem, style, glyph_index,
-                             X_SCALING_Rules, X_SCALING_RULES_SIZE );
+  static FT_Bool
+  sph_rule_applies( TT_Face       face,
+                    SPH_FaceRule  rule,
+                    FT_UInt       ppem,
+                    FT_UInt       glyph_index )
+  {
+    if ( rule->ppem && rule->ppem != ppem )
+      return FALSE;
+
+    if ( rule->glyph                                       &&
+         FT_Get_Char_Index( (FT_Face)face,
+                            rule->glyph ) != glyph_index )
+      return FALSE;
+
+    return TRUE;
   }
 
 
-#define TWEAK_RULES( x )                                       \
-  if ( sph_test_tweak( face, family, ppem, style, glyph_index, \
-                       x##_Rules, x##_RULES_SIZE ) )           \
-    loader->exec->sph_tweak_flags |= SPH_TWEAK_##x;
+  FT_LOCAL_DEF( FT_UInt )
+  sph_test_tweak_x_scaling( TT_Face  face,
+                            FT_UInt  ppem,
+                            FT_UInt  glyph_index )
+  {
+    SPH_FaceRule  rule;
+    SPH_FaceRule  limit;
+
 
-#define TWEAK_RULES_EXCEPTIONS( x )                                        \
-  if ( sph_test_tweak( face, family, ppem, style, glyph_index,             \
-                       x##_Rules_Exceptions, x##_RULES_EXCEPTIONS_SIZE ) ) \
-    loader->exec->sph_tweak_flags &= ~SPH_TWEAK_##x;
+    if ( !face->sph_rules_compiled )
+      sph_compile_rules( face );
+
+    rule  = (SPH_FaceRule)face->sph_rules;
+    limit = rule + face->sph_num_rules;
+
+    for ( ; rule < limit; rule++ )
+      if ( rule->scale                                       &&
+           sph_rule_applies( face, rule, ppem, glyph_index ) )
+        return (FT_UInt)rule->scale;
+
+    return 1000;
+  }
 
 
   FT_LOCAL_DEF( void )
   sph_set_tweaks( TT_Loader  loader,
                   FT_UInt    glyph_index )
   {
-    TT_Face     face   = loader->face;
-    FT_String*  family = face->root.family_name;
-    FT_UInt     ppem   = loader->size->metrics->x_ppem;
-    FT_String*  style  = face->root.style_name;
+    TT_Face  face = loader->face;
+    FT_UInt  ppem = loader->size->metrics->x_ppem;
+
+    SPH_FaceRule  rule;
+    SPH_FaceRule  limit;
+    FT_ULong      set_flags   = 0;
+    FT_ULong      clear_flags = 0;
 
 
     /* don't apply rules if style isn't set */
@@ -915,41 +1031,41 @@
 
 #ifdef SPH_DEBUG_MORE_VERBOSE
     printf( "%s,%d,%s,%c=%d ",
-            family, ppem, style, glyph_index, glyph_index );
+            face->root.family_name, ppem, face->root.style_name,
+            glyph_index, glyph_index );
 #endif
 
-    TWEAK_RULES( PIXEL_HINTING );
+    if ( !face->sph_rules_compiled )
+      sph_compile_rules( face );
 
-    if ( loader->exec->sph_tweak_flags & SPH_TWEAK_PIXEL_HINTING )
-    {
-      loader->exec->ignore_x_mode = FALSE;
-      return;
-    }
+    rule  = (SPH_FaceRule)face->sph_rules;
+    limit = rule + face->sph_num_rules;
 
-    TWEAK_RULES( ALLOW_X_DMOVE );
-    TWEAK_RULES( ALWAYS_DO_DELTAP );
-    TWEAK_RULES( ALWAYS_SKIP_DELTAP );
-    TWEAK_RULES( DEEMBOLDEN );
-    TWEAK_RULES( DO_SHPIX );
-    TWEAK_RULES( EMBOLDEN );
-    TWEAK_RULES( MIAP_HACK );
-    TWEAK_RULES( NORMAL_ROUND );
-    TWEAK_RULES( NO_ALIGNRP_AFTER_IUP );
-    TWEAK_RULES( NO_CALL_AFTER_IUP );
-    TWEAK_RULES( NO_DELTAP_AFTER_IUP );
-    TWEAK_RULES( RASTERIZER_35 );
-    TWEAK_RULES( SKIP_IUP );
-
-    TWEAK_RULES( SKIP_OFFPIXEL_Y_MOVES );
-    TWEAK_RULES_EXCEPTIONS( SKIP_OFFPIXEL_Y_MOVES );
+    for ( ; rule < limit; rule++ )
+    {
+      if ( !( rule->set_flags | rule->clear_flags ) )
+        continue;
 
-    TWEAK_RULES( SKIP_NONPIXEL_Y_MOVES_DELTAP );
+      if ( sph_rule_applies( face, rule, ppem, glyph_index ) )
+      {
+        set_flags   |= rule->set_flags;
+        clear_flags |= rule->clear_flags;
+      }
+    }
 
-    TWEAK_RULES( SKIP_NONPIXEL_Y_MOVES );
-    TWEAK_RULES_EXCEPTIONS( SKIP_NONPIXEL_Y_MOVES );
+    if ( set_flags & SPH_TWEAK_PIXEL_HINTING )
+    {
+      loader->exec->sph_tweak_flags |= SPH_TWEAK_PIXEL_HINTING;
+      loader->exec->ignore_x_mode    = FALSE;
+      return;
+    }
 
-    TWEAK_RULES( ROUND_NONPIXEL_Y_MOVES );
-    TWEAK_RULES_EXCEPTIONS( ROUND_NONPIXEL_Y_MOVES );
+    loader->exec->sph_tweak_flags |= set_flags                     &
+                                     ~clear_flags                  &
+                                     ~( SPH_TWEAK_TIMES_NEW_ROMAN_HACK |
+                                        SPH_TWEAK_COURIER_NEW_2_HACK   |
+                                        SPH_RULE_COMPATIBILITY_MODE    |
+                                        SPH_RULE_COMPATIBLE_WIDTHS     );
 
     if ( loader->exec->sph_tweak_flags & SPH_TWEAK_RASTERIZER_35 )
     {
@@ -982,20 +1098,16 @@
     }
 
     if ( IS_HINTED( loader->load_flags ) )
-    {
-      TWEAK_RULES( TIMES_NEW_ROMAN_HACK );
-      TWEAK_RULES( COURIER_NEW_2_HACK );
-    }
+      loader->exec->sph_tweak_flags |= set_flags                        &
+                                       ( SPH_TWEAK_TIMES_NEW_ROMAN_HACK |
+                                         SPH_TWEAK_COURIER_NEW_2_HACK   );
 
-    if ( sph_test_tweak( face, family, ppem, style, glyph_index,
-           COMPATIBILITY_MODE_Rules, COMPATIBILITY_MODE_RULES_SIZE ) )
+    if ( set_flags & SPH_RULE_COMPATIBILITY_MODE )
       loader->exec->face->sph_compatibility_mode = TRUE;
 
-
     if ( IS_HINTED( loader->load_flags ) )
     {
-      if ( sph_test_tweak( face, family, ppem, style, glyph_index,
-             COMPATIBLE_WIDTHS_Rules, COMPATIBLE_WIDTHS_RULES_SIZE ) )
+      if ( set_flags & SPH_RULE_COMPATIBLE_WIDTHS )
         loader->exec->compatible_widths |= TRUE;
     }
   }
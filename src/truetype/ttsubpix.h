@@ -71,21 +71,27 @@ FT_BEGIN_HEADER
 #define SPH_TWEAK_SKIP_NONPIXEL_Y_MOVES_DELTAP    0x0080000UL
 
 
-  FT_LOCAL( FT_Bool )
-  sph_test_tweak( TT_Face               face,
-                  const FT_String*      family,
-                  FT_UInt               ppem,
-                  const FT_String*      style,
-                  FT_UInt               glyph_index,
-                  const SPH_TweakRule*  rule,
-                  FT_UInt               num_rules );
+  /**************************************************************************
+   *
+   * A rule whose family and style match the face; the remaining conditions
+   * are checked for each glyph.  `scale' is non-zero for x scaling rules.
+   *
+   */
+  typedef struct  SPH_FaceRuleRec_
+  {
+    FT_ULong  set_flags;
+    FT_ULong  clear_flags;
+    FT_UInt   ppem;
+    FT_ULong  glyph;
+    FT_ULong  scale;
+
+  } SPH_FaceRuleRec, *SPH_FaceRule;
+
 
   FT_LOCAL( FT_UInt )
-  sph_test_tweak_x_scaling( TT_Face           face,
-                            const FT_String*  family,
-                            FT_UInt           ppem,
-                            const FT_String*  style,
-                            FT_UInt           glyph_index );
+  sph_test_tweak_x_scaling( TT_Face  face,
+                            FT_UInt  ppem,
+                            FT_UInt  glyph_index );
 
   FT_LOCAL( void )
   sph_set_tweaks( TT_Loader  loader,
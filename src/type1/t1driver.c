@@ -72,9 +72,24 @@
   t1_get_name_index( T1_Face           face,
                      const FT_String*  glyph_name )
   {
-    FT_Int  i;
+    T1_Font  type1 = &face->type1;
+    FT_Int   i;
 
 
+    if ( type1->glyph_names_hash                                    ||
+         !ft_hash_str_new_names( &type1->glyph_names_hash,
+                                 (FT_UInt)type1->num_glyphs,
+                                 NULL, type1->glyph_names,
+                                 FT_FACE_MEMORY( face ) )           )
+    {
+      size_t*  idx = ft_hash_str_lookup( glyph_name,
+                                         type1->glyph_names_hash );
+
+
+      return idx ? (FT_UInt)*idx : 0;
+    }
+
+    /* out of memory; fall back to a linear search */
     for ( i = 0; i < face->type1.num_glyphs; i++ )
     {
       FT_String*  gname = face->type1.glyph_names[i];
@@ -133,7 +148,10 @@
     (FT_Get_MM_WeightVector_Func)T1_Get_MM_WeightVector, /* get_mm_weightvector */
 
     (FT_Get_Var_Blend_Func)      NULL,                   /* get_var_blend       */
-    (FT_Done_Blend_Func)         T1_Done_Blend           /* done_blend          */
+    (FT_Done_Blend_Func)         T1_Done_Blend,          /* done_blend          */
+
+    (FT_Set_Size_Var_Func)       NULL,                   /* set_size_mm_blend   */
+    (FT_Set_Size_Var_Func)       NULL                    /* set_size_var_design */
   };
 #endif
 
@@ -70,8 +70,8 @@
     /* For incremental fonts get the character data using the */
     /* callback function.                                     */
     if ( inc )
-      error = inc->funcs->get_glyph_data( inc->object,
-                                          glyph_index, char_string );
+      error = ft_incremental_get_glyph_data( FT_FACE( face ),
+                                             glyph_index, char_string );
     else
 
 #endif /* FT_CONFIG_OPTION_INCREMENTAL */
@@ -40,6 +40,7 @@
 #include "t42objs.h"
 #include "t42error.h"
 #include <freetype/internal/ftdebug.h>
+#include <freetype/internal/fthash.h>
 
 #include <freetype/internal/services/svfntfmt.h>
 #include <freetype/internal/services/svgldict.h>
@@ -72,9 +73,28 @@
   t42_get_name_index( T42_Face          face,
                       const FT_String*  glyph_name )
   {
-    FT_Int  i;
+    T1_Font  type1 = &face->type1;
+    FT_Int   i;
 
 
+    if ( type1->glyph_names_hash                                    ||
+         !ft_hash_str_new_names( &type1->glyph_names_hash,
+                                 (FT_UInt)type1->num_glyphs,
+                                 NULL, type1->glyph_names,
+                                 FT_FACE_MEMORY( face ) )           )
+    {
+      size_t*  idx = ft_hash_str_lookup( glyph_name,
+                                         type1->glyph_names_hash );
+
+
+      if ( !idx )
+        return 0;
+
+      return (FT_UInt)ft_strtol( (const char *)type1->charstrings[*idx],
+                                 NULL, 10 );
+    }
+
+    /* out of memory; fall back to a linear search */
     for ( i = 0; i < face->type1.num_glyphs; i++ )
     {
       FT_String*  gname = face->type1.glyph_names[i];
@@ -429,6 +429,9 @@
     FT_FREE( info->weight );
 
     /* release top dictionary */
+    ft_hash_str_free( type1->glyph_names_hash, memory );
+    FT_FREE( type1->glyph_names_hash );
+
     FT_FREE( type1->charstrings_len );
     FT_FREE( type1->charstrings );
     FT_FREE( type1->glyph_names );
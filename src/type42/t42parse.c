@@ -535,6 +535,7 @@
     T42_Parser  parser = &loader->parser;
     FT_Memory   memory = parser->root.memory;
     FT_Byte*    cur;
+    FT_Byte*    end;
     FT_Byte*    limit  = parser->root.limit;
     FT_Error    error;
     FT_Int      num_tables = 0;
@@ -599,27 +600,39 @@
           goto Fail;
         }
 
-        T1_Skip_PS_Token( parser );
-        if ( parser->root.error )
-          goto Exit;
+        /* Locate the end of the string with a fast byte search      */
+        /* instead of tokenizing; the data gets validated while being */
+        /* decoded.                                                   */
+        end = (FT_Byte*)ft_memchr( cur, '>', (FT_Offset)( limit - cur ) );
+        if ( !end )
+          end = limit;
 
         /* don't include delimiters */
-        string_size = (FT_ULong)( ( parser->root.cursor - cur - 2 + 1 ) / 2 );
+        string_size = (FT_ULong)( ( end - cur ) / 2 );
         if ( !string_size )
         {
           FT_ERROR(( "t42_parse_sfnts: invalid data in sfnts array\n" ));
           error = FT_THROW( Invalid_File_Format );
           goto Fail;
         }
-        if ( FT_REALLOC( string_buf, old_string_size, string_size ) )
-          goto Fail;
+
+        /* the buffer only grows; its contents are overwritten anyway */
+        if ( string_size > old_string_size )
+        {
+          if ( FT_QREALLOC( string_buf, old_string_size, string_size ) )
+            goto Fail;
+
+          old_string_size = string_size;
+        }
 
         allocated = 1;
 
         parser->root.cursor = cur;
-        (void)T1_ToBytes( parser, string_buf, string_size, &real_size, 1 );
-        old_string_size = string_size;
-        string_size     = real_size;
+        error = T1_ToBytes( parser, string_buf, string_size, &real_size, 1 );
+        if ( error )
+          goto Fail;
+
+        string_size = real_size;
       }
 
       else if ( ft_isdigit( *cur ) )
@@ -685,16 +698,21 @@
 
       size = (FT_ULong)( limit - parser->root.cursor );
 
-      for ( n = 0; n < string_size; n++ )
+      /* Data gets copied in chunks up to the next state change. */
+      n = 0;
+      while ( n < string_size )
       {
+        FT_ULong  chunk = 0;
+
+
         switch ( status )
         {
         case BEFORE_START:
           /* load offset table, 12 bytes */
           if ( count < 12 )
           {
-            face->ttf_data[count++] = string_buf[n];
-            continue;
+            chunk = (FT_ULong)( 12 - count );
+            break;
           }
           else
           {
@@ -718,8 +736,8 @@
           /* the offset table is read; read the table directory */
           if ( count < face->ttf_size )
           {
-            face->ttf_data[count++] = string_buf[n];
-            continue;
+            chunk = (FT_ULong)( face->ttf_size - count );
+            break;
           }
           else
           {
@@ -762,8 +780,15 @@
             error = FT_THROW( Invalid_File_Format );
             goto Fail;
           }
-          face->ttf_data[count++] = string_buf[n];
+          chunk = (FT_ULong)( face->ttf_size - count );
         }
+
+        if ( chunk > string_size - n )
+          chunk = string_size - n;
+
+        FT_MEM_COPY( face->ttf_data + count, string_buf + n, chunk );
+        count += (FT_Long)chunk;
+        n     += chunk;
       }
 
       T1_Skip_Spaces( parser );